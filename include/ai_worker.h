@@ -0,0 +1,14 @@
+#ifndef AI_WORKER_H
+#define AI_WORKER_H
+
+#include <common.h>
+
+AiWorker* init_ai_worker(const AiModels* models);
+void cleanup_ai_worker(AiWorker* worker);
+void ai_worker_submit(AiWorker* worker, const GameContext* context);
+bool ai_worker_poll(AiWorker* worker, EvalResult* result, SearchStats* stats);
+bool ai_worker_busy(AiWorker* worker);
+void ai_worker_cancel(AiWorker* worker);
+void ai_worker_ponder(AiWorker* worker, const GameContext* context);
+
+#endif //AI_WORKER_H
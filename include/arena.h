@@ -0,0 +1,40 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <mem_stats.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define ARENA_ALIGNMENT 16
+#define SESSION_ARENA_BLOCK_SIZE (64 * 1024)
+#define FRAME_ARENA_BLOCK_SIZE (16 * 1024)
+
+typedef struct ArenaBlock ArenaBlock;
+
+/**
+ * Bump allocator, allocations are only released together by reset_arena() or
+ * free_arena(). Not thread-safe, both arenas below belong to the main thread.
+ * Every allocation is accounted to the subsystem it is made for.
+ */
+typedef struct {
+    const char* name;
+    ArenaBlock* blocks;    // Most recent first
+    size_t block_size;
+    size_t used;           // Bytes handed out since the last reset
+    size_t peak;
+    size_t used_by[MEM_SUBSYSTEM_COUNT]; // used split by subsystem
+} Arena;
+
+// Data living until the game exits: caches, workers, models
+extern Arena session_arena;
+// Scratch data for the frame being drawn, reset after EndDrawing()
+extern Arena frame_arena;
+
+void* arena_alloc(Arena* arena, MemSubsystem subsystem, size_t size);
+void* arena_calloc(Arena* arena, MemSubsystem subsystem, size_t count, size_t size);
+char* arena_printf(Arena* arena, MemSubsystem subsystem, const char* format, ...);
+void reset_arena(Arena* arena);
+void free_arena(Arena* arena);
+
+#endif //ARENA_H
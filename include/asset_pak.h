@@ -0,0 +1,56 @@
+#ifndef ASSET_PAK_H
+#define ASSET_PAK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define ASSET_PAK_FILE "assets.pak"
+#define ASSET_PAK_MAGIC 0x4B415054u // "TPAK" read as a little endian uint32
+#define ASSET_PAK_VERSION 1
+#define ASSET_PAK_ALIGNMENT 16
+#define ASSET_PAK_NAME_LEN 48
+
+/**
+ * On-disk layout of assets.pak, written by tools/asset_packer.c:
+ * an AssetPakHeader, entry_count AssetPakEntry records sorted by name, then the
+ * entry data, each entry starting on an ASSET_PAK_ALIGNMENT boundary. Names are the
+ * paths the game would otherwise open, e.g. "assets/main1.png". Entries hold the
+ * original encoded bytes, so images and audio are decoded straight from the pak.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+} AssetPakHeader;
+
+typedef struct {
+    char name[ASSET_PAK_NAME_LEN]; // NUL terminated
+    uint64_t offset;               // From the start of the pak
+    uint64_t size;
+} AssetPakEntry;
+
+_Static_assert(sizeof(AssetPakHeader) == 16, "AssetPakHeader must stay 16 bytes");
+_Static_assert(sizeof(AssetPakEntry) == 64, "AssetPakEntry must stay 64 bytes");
+
+/**
+ * Sequential reader over one asset, backed by the pak when it holds the asset and
+ * by the loose file otherwise
+ */
+typedef struct {
+    const unsigned char* data;
+    size_t size;
+    size_t position;
+    FILE* file;
+} AssetReader;
+
+bool open_asset_pak(void);
+void close_asset_pak(void);
+const unsigned char* find_pak_asset(const char* path, int* size);
+bool open_asset_reader(AssetReader* reader, const char* path);
+size_t read_asset(AssetReader* reader, void* destination, size_t bytes);
+void close_asset_reader(AssetReader* reader);
+
+#endif //ASSET_PAK_H
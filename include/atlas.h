@@ -0,0 +1,29 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include <common.h>
+
+// Widest row the packer builds before starting a new shelf
+#define ATLAS_MAX_WIDTH 2048
+#define ATLAS_PADDING 2
+
+// Sprites are resampled to the size they are drawn at, then drawn 1:1
+#define MENU_IMAGE_SCALE 0.3f  // Of the window size
+#define MUSIC_ICON_SCALE 0.08f // Of the icon's source size
+// Window size has to stay the same this long before sprites are resampled again
+#define ATLAS_REFRESH_DELAY_SECONDS 0.1
+
+const char* sprite_path(SpriteId sprite);
+void resample_sprite_image(Image* image, SpriteId sprite, int screen_width, int screen_height);
+bool refresh_texture_atlas(TextureAtlas* atlas, int screen_width, int screen_height);
+bool update_texture_atlas(TextureAtlas* atlas, bool resized);
+Image pack_texture_atlas(const Image images[SPRITE_COUNT], Rectangle sprites[SPRITE_COUNT]);
+TextureAtlas upload_texture_atlas(Image packed, const Rectangle sprites[SPRITE_COUNT]);
+TextureAtlas build_texture_atlas(const Image images[SPRITE_COUNT]);
+void unload_texture_atlas(TextureAtlas* atlas);
+Vector2 sprite_size(const TextureAtlas* atlas, SpriteId sprite);
+Vector2 sprite_draw_size(const TextureAtlas* atlas, SpriteId sprite, int screen_width, int screen_height);
+void draw_sprite(const TextureAtlas* atlas, SpriteId sprite, Vector2 position, float scale, Color tint);
+void draw_sprite_sized(const TextureAtlas* atlas, SpriteId sprite, Rectangle dest, Color tint);
+
+#endif //ATLAS_H
@@ -0,0 +1,25 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <common.h>
+
+// Events posted between two pumps of the audio thread, more are dropped
+#define AUDIO_QUEUE_CAPACITY 64
+// The music stream is refilled and queued events are played at this interval
+#define AUDIO_PUMP_INTERVAL_MS 5
+
+typedef enum {
+    SFX_CLICK,
+    SFX_SYMBOL,
+    SFX_WIN,
+    SFX_DRAW,
+    SFX_COUNT
+} SfxId;
+
+bool init_audio(Music* music);
+void cleanup_audio(void);
+void play_sfx(SfxId sfx);
+void play_music(void);
+void stop_music(void);
+
+#endif //AUDIO_H
@@ -0,0 +1,29 @@
+#ifndef BUTTON_MESH_H
+#define BUTTON_MESH_H
+
+#include <raylib.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Matches the tessellation DrawRectangleRounded used for buttons
+#define BUTTON_ROUNDNESS 0.3f
+#define BUTTON_CORNER_SEGMENTS 20
+#define BUTTON_OUTLINE_THICKNESS 2.0f
+
+#define BUTTON_PERIMETER_POINTS (4 * (BUTTON_CORNER_SEGMENTS + 1))
+#define BUTTON_FILL_VERTICES (3 * BUTTON_PERIMETER_POINTS)
+#define BUTTON_OUTLINE_VERTICES (6 * BUTTON_PERIMETER_POINTS)
+
+// Triangle lists of a button's fill and outline, built once per layout generation
+typedef struct ButtonGeometry {
+    Vector2 fill[BUTTON_FILL_VERTICES];
+    int fill_count;
+    Vector2 outline[BUTTON_OUTLINE_VERTICES];
+    int outline_count;
+} ButtonGeometry;
+
+void tessellate_button(ButtonGeometry* geometry, Rectangle rect, bool rounded);
+void draw_button_geometry(const ButtonGeometry* const geometries[], const Color fill_colors[], size_t count,
+                          Color outline_color);
+
+#endif //BUTTON_MESH_H
@@ -1,10 +1,16 @@
 #ifndef BUTTONS_H
 #define BUTTONS_H
 #include "common.h"
+#include <button_mesh.h>
+
+// Largest number of buttons shown together on one screen
+#define MAX_BUTTON_GROUP_SIZE 8
 
 typedef struct
 {
     Rectangle* rect;
+    ButtonGeometry* geometry; // Fill and outline triangles of rect
+    bool hovered;
     const char* text;
     Color color;
     const float width;
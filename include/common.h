@@ -21,7 +21,8 @@ typedef enum {
     GAME_STATE_DRAW,
     MENU_INSTRUCTIONS,
     MENU_SETTINGS,
-    GAME_STATE_EXIT
+    GAME_STATE_EXIT,
+    GAME_STATE_SPECTATOR
 } GameState;
 
 typedef enum {
@@ -54,29 +55,47 @@ typedef struct {
 
 // Game-related structures
 typedef struct {
-    double start_time;
+    double elapsed; // Simulated seconds since the transition started
     bool active;
 } ActiveTransition;
 
 
+// Per-search statistics, only collected when a SearchStats is passed to the engine
+typedef struct {
+    uint64_t nodes;                // Positions visited, including the root
+    uint64_t leaf_evals;           // Terminal, depth limit and model evaluations
+    uint64_t cutoffs;              // Alpha-beta cutoffs
+    uint64_t cutoffs_by_move[9];   // Cutoffs by index of the move tried at that node
+    uint64_t tt_hits;              // Searches answered from a cached position
+    int search_depth;              // Depth limit the search started with
+    int max_ply;                   // Deepest ply reached
+    double effective_branching;    // nodes^(1/max_ply)
+    double wall_time;              // Seconds spent searching
+} SearchStats;
+
 typedef struct
 {
-    NeuralNetwork* neural_network;
-    BayesModel* bayes_model;
+    const NeuralNetwork* neural_network; // Read-only, possibly shared with other instances
+    const BayesModel* bayes_model;
 } AiModels;
 
+typedef enum {
+    SPRITE_MAIN_MENU,
+    SPRITE_MUSIC_ON,
+    SPRITE_MUSIC_OFF,
+    SPRITE_COUNT
+} SpriteId;
+
+// UI images packed into one texture, sprites are sub-rectangles of it
 typedef struct {
-    Music background_music;
-    Sound fx_click;
-    Sound fx_symbol;
-    Sound fx_win;
-    Sound fx_draw;
-    Texture2D main_menu_img;
-    Texture2D instructions_1;
-    Texture2D music_on;
-    Texture2D music_off;
-    Texture2D instructions_2;
-    AiModels* models;
+    Texture2D texture;
+    Rectangle sprites[SPRITE_COUNT];
+} TextureAtlas;
+
+typedef struct {
+    Music background_music; // Owned by the audio thread once started, see audio.h
+    TextureAtlas atlas;
+    AiModels* models; // Owned by the resource manager, see resource_manager.h
 } GameResources;
 
 typedef struct {
@@ -85,6 +104,7 @@ typedef struct {
     Color btn_clicked_color;
 } UiOptions;
 
+// Keys are hashed and compared bytewise, zero any padding before a lookup
 typedef struct {
     float width_percentage;
     float height_percentage;
@@ -92,16 +112,50 @@ typedef struct {
     int screen_width;
 } BoxKey;
 
+#define TEXT_CACHE_MAX_LEN 64
+
+// Text is measured by content, the key is zero padded so it can be hashed bytewise
 typedef struct {
-    BoxKey key;
-    BoxDimensions result;
-    UT_hash_handle hh;
-} BoxCache;
+    int font_size;
+    char text[TEXT_CACHE_MAX_LEN];
+} TextKey;
+
+#define MEMO_BOX_CAPACITY 64
+#define MEMO_TEXT_CAPACITY 256
 
 typedef struct {
-    BoxCache* box_cache;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+} MemoStats;
+
+// Fixed-capacity open-addressing table, see memo.c
+typedef struct {
+    unsigned char* slots;  // capacity slots allocated once, header then key then value
+    size_t key_size;
+    size_t value_size;
+    size_t slot_size;
+    uint32_t capacity;     // Power of two
+    uint32_t clock_hand;
+    MemoStats stats;
+} MemoTable;
+
+typedef struct {
+    MemoTable boxes;       // BoxKey -> BoxDimensions
+    MemoTable text_widths; // TextKey -> int
 } MemoCache;
 
+// Screen layout, rebuilt in one pass whenever the generation is bumped on resize
+typedef struct {
+    uint32_t generation;
+    BoxDimensions game_over_box;
+    BoxDimensions exit_box;
+    BoxDimensions mode_choice_box;
+} Layout;
+
+typedef struct AiWorker AiWorker;
+typedef struct SpectatorWall SpectatorWall;
+
 typedef struct {
     float grid_size;
     int cell_size;
@@ -110,12 +164,14 @@ typedef struct {
 } GridDimensions;
 
 typedef struct {
-    bool needs_recalculation;
     bool exit_flag;
     GameState state;
     GameMode selected_game_mode;
     player_t player_1;
     bool computer_enabled;
+    bool pondering_enabled;
+    bool search_stats_enabled;
+    bool memory_stats_enabled;
     bool audio_disabled;
     ActiveTransition transition;
     bool start_screen_shown;
@@ -123,7 +179,11 @@ typedef struct {
     int p2_score;
     int draw_score; 
     GridDimensions grid;
+    Layout layout;
     MemoCache* memo_cache;
+    AiWorker* ai_worker;
+    SpectatorWall* spectator;
+    SearchStats last_search_stats;
 } GameContext;
 
 #endif // COMMON_H
\ No newline at end of file
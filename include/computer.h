@@ -2,12 +2,18 @@
 #define COMPUTER_H
 #include <game.h>
 #include <neural.h>
+#include <stdatomic.h>
 
 
 EvalResult minimax(player_t current_player, int alpha, int beta, int depth, const GameContext* context);
 
+void set_search_abort_flag(atomic_bool* flag);
+AiModels* load_ai_models(void);
+void unload_ai_models(AiModels* models);
+EvalResult choose_computer_move(const GameContext* context, const AiModels* models, SearchStats* stats);
+void format_search_stats(const SearchStats* stats, char* buffer, size_t size);
 void computer_move(const GameContext* context, const AiModels* models);
 EvalResult nb_move(const BayesModel* model, player_t computer_player);
-EvalResult nn_move(NeuralNetwork* nn, player_t computer_player);
+EvalResult nn_move(const NeuralNetwork* nn, player_t computer_player);
 
 #endif //COMPUTER_H
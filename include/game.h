@@ -6,8 +6,9 @@
 #include "common.h"
 
 // Use 16-bit string to represent a player's board
-extern uint16_t x_board;
-extern uint16_t o_board;
+// Boards are thread-local so engine workers can search their own position
+extern _Thread_local uint16_t x_board;
+extern _Thread_local uint16_t o_board;
 
 #define BOARD_SIZE 3
 
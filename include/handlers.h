@@ -3,9 +3,11 @@
 #include <buttons.h>
 #include <game.h>
 #include <raylib.h>
+#include <ui_tree.h>
 
 void handle_game_click(Vector2 mouse_pos, const GameResources* resources, GameContext* context);
-void handle_clicks(Vector2 click_pos, const GameResources* resources, GameContext* context, const Button* buttons, size_t count);
+void handle_computer_move(const GameResources* resources, GameContext* context, EvalResult result);
+void handle_clicks(Vector2 click_pos, const GameResources* resources, GameContext* context, UiScreenId screen);
 void handle_menu_click(Vector2 mouse_pos, const GameResources* resources, GameContext* context);
 void handle_music_toggle(const GameResources* resources, GameContext* context);
 
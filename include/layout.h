@@ -0,0 +1,8 @@
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <common.h>
+
+void update_layout(GameContext* context);
+
+#endif //LAYOUT_H
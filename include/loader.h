@@ -0,0 +1,18 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include <common.h>
+
+#define ASSET_LOADER_THREADS 4
+
+typedef struct AssetLoader AssetLoader;
+
+AssetLoader* start_asset_loader(int screen_width, int screen_height);
+float asset_loader_progress(AssetLoader* loader);
+bool asset_loader_done(AssetLoader* loader);
+GameResources finish_asset_loading(AssetLoader* loader);
+Image load_image_asset(const char* path);
+Wave load_wave_asset(const char* path);
+Music load_music_asset(const char* path);
+
+#endif //LOADER_H
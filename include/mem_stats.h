@@ -0,0 +1,42 @@
+#ifndef MEM_STATS_H
+#define MEM_STATS_H
+
+#include <raylib.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Interval of the memory log line
+#define MEM_REPORT_SECONDS 60.0
+
+typedef enum {
+    MEM_UI,      // Render layers, font, per-frame strings
+    MEM_MEMO,    // Memoization tables
+    MEM_ASSETS,  // Sprites, instruction images, the asset loader
+    MEM_AI,      // Models, AI worker, spectator matches
+    MEM_AUDIO,   // Decoded sound effects
+    MEM_SUBSYSTEM_COUNT
+} MemSubsystem;
+
+typedef enum {
+    MEM_HEAP,    // CPU memory
+    MEM_GPU,     // Texture and render target memory
+    MEM_KIND_COUNT
+} MemKind;
+
+typedef struct {
+    size_t current;
+    size_t peak;
+    uint64_t total;  // Bytes ever allocated, keeps growing with churn while current stays flat
+} MemCounter;
+
+void track_alloc(MemSubsystem subsystem, MemKind kind, size_t bytes);
+void track_free(MemSubsystem subsystem, MemKind kind, size_t bytes);
+size_t texture_bytes(Texture2D texture);
+size_t render_texture_bytes(RenderTexture2D target);
+MemCounter get_mem_counter(MemSubsystem subsystem, MemKind kind);
+const char* mem_subsystem_name(MemSubsystem subsystem);
+void log_mem_usage(const char* label);
+void report_mem_usage(void);
+
+#endif //MEM_STATS_H
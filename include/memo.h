@@ -3,8 +3,56 @@
 
 #include "common.h"
 
+// Slots probed from a key's home slot, also the window CLOCK picks a victim from
+#define MEMO_PROBE_LIMIT 8
+
+// Default number of entries of a DEFINE_MEMO table
+#define MEMO_FUNCTION_CAPACITY 32
+
+// Memo table of one function, its entries are only valid for one layout generation
+typedef struct MemoFunction {
+    const char* name;
+    uint32_t capacity;
+    size_t key_size;
+    size_t value_size;
+    uint32_t generation;
+    MemoTable table;            // Allocated on first use
+    struct MemoFunction* next;  // Registered functions, for reporting and cleanup
+} MemoFunction;
+
+/**
+ * Defines the memo table of a function and typed lookup helpers for it.
+ *
+ *     DEFINE_MEMO(button_rect, ButtonRectKey, Rectangle, MEMO_FUNCTION_CAPACITY)
+ *
+ * gives button_rect_memo_get(&key, &value) and button_rect_memo_put(&key, &value).
+ * Keys are compared bytewise, memset them to zero before filling them in. Entries
+ * computed for an older layout generation are dropped on the next lookup.
+ */
+#define DEFINE_MEMO(name, KeyType, ValueType, entries)                                     \
+    static MemoFunction name##_memo = {#name, (entries), sizeof(KeyType), sizeof(ValueType)}; \
+    static inline bool name##_memo_get(const KeyType* key, ValueType* value)               \
+    {                                                                                      \
+        return memo_function_get(&name##_memo, key, value);                                \
+    }                                                                                      \
+    static inline void name##_memo_put(const KeyType* key, const ValueType* value)         \
+    {                                                                                      \
+        memo_function_put(&name##_memo, key, value);                                       \
+    }
+
 MemoCache* init_memo_cache(void);
 
 void cleanup_memo_cache(MemoCache* cache);
 
-#endif //MEMO_H
\ No newline at end of file
+bool init_memo_table(MemoTable* table, uint32_t capacity, size_t key_size, size_t value_size);
+void cleanup_memo_table(MemoTable* table);
+void clear_memo_table(MemoTable* table);
+bool memo_table_get(MemoTable* table, const void* key, void* value);
+void memo_table_put(MemoTable* table, const void* key, const void* value);
+
+void set_memo_generation(uint32_t generation);
+bool memo_function_get(MemoFunction* function, const void* key, void* value);
+void memo_function_put(MemoFunction* function, const void* key, const void* value);
+void report_memo_stats(void);
+
+#endif //MEMO_H
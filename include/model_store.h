@@ -0,0 +1,53 @@
+#ifndef MODEL_STORE_H
+#define MODEL_STORE_H
+
+#include <neural.h>
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MODEL_STORE_MAGIC 0x534D5454u // "TTMS" read as a little endian uint32
+#define MODEL_STORE_VERSION 1
+#define MODEL_STORE_ALIGNMENT 64
+// How long an instance waits for another one to finish building the store
+#define MODEL_STORE_ATTACH_TIMEOUT_MS 2000
+
+#define MODEL_STORE_BUILDING 0u
+#define MODEL_STORE_READY 1u
+
+typedef enum {
+    MODEL_SECTION_NEURAL_NETWORK,
+    MODEL_SECTION_BAYES,
+    MODEL_SECTION_COUNT
+} ModelSectionId;
+
+typedef struct {
+    uint64_t offset; // From the start of the store, 0 if the model failed to load
+    uint64_t size;
+} ModelSection;
+
+/**
+ * Layout of the shared model store: a ModelStoreHeader, then every section on a
+ * MODEL_STORE_ALIGNMENT boundary. Sections hold the in-memory structs, so they are
+ * used in place. The store is named after the user, MODEL_STORE_VERSION and the
+ * fingerprint of the model assets, so instances built from other assets never open
+ * it; the header repeats the version and fingerprint and adds a checksum so a
+ * mismatch is still caught.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t header_size;
+    _Atomic uint32_t state;  // MODEL_STORE_READY once the builder has filled everything in
+    uint64_t fingerprint;    // FNV-1a of the model assets and the section layout
+    uint64_t checksum;       // FNV-1a of every section
+    uint64_t total_size;
+    ModelSection sections[MODEL_SECTION_COUNT];
+} ModelStoreHeader;
+
+const NeuralNetwork* shared_neural_network(void);
+const BayesModel* shared_bayes_model(void);
+void detach_model_store(void);
+
+#endif //MODEL_STORE_H
@@ -60,9 +60,13 @@ typedef struct {
     int move;
 } EvalResult;
 
+#include <stdbool.h>
+
+bool read_naive_bayes(BayesModel* model);
 BayesModel* load_naive_bayes();
-void forward_pass(NeuralNetwork *nn, const double input[]);
+void forward_pass(const NeuralNetwork *nn, const double input[], double hidden_layer[], double output_layer[]);
 double predict_naive_bayes(const BayesModel* model, int computer_player);
+bool read_model(NeuralNetwork* nn);
 NeuralNetwork* load_model();
 
 #endif //NEURAL_H
@@ -0,0 +1,36 @@
+#ifndef REDRAW_H
+#define REDRAW_H
+
+#include <game.h>
+#include <time.h>
+
+// Input is still polled at this rate while nothing is redrawn
+#define IDLE_TICK_SECONDS (1.0 / 30.0)
+#define FORCED_REDRAW_SECONDS 1.0
+#define UTILISATION_REPORT_SECONDS 30.0
+
+typedef struct {
+    // Snapshot of what the last drawn frame showed
+    GameState state;
+    uint16_t x_board;
+    uint16_t o_board;
+    bool audio_disabled;
+    bool start_screen_shown;
+    bool search_stats_enabled;
+    bool animating;
+    double last_draw_time;
+
+    // Utilisation since the last report
+    double report_since;
+    clock_t cpu_since;
+    int frames_drawn;
+    int idle_ticks;
+} RedrawTracker;
+
+void init_redraw_tracker(RedrawTracker* tracker);
+bool frame_needs_redraw(const RedrawTracker* tracker, const GameContext* context, bool resized);
+void note_frame_drawn(RedrawTracker* tracker, const GameContext* context);
+void wait_idle_tick(RedrawTracker* tracker);
+void report_render_utilisation(RedrawTracker* tracker, bool event_driven);
+
+#endif //REDRAW_H
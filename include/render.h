@@ -12,13 +12,16 @@ void render_instructions(
     const GameResources* resources, const UiOptions* render_opts, const GameContext* context);
 void render_exit(const UiOptions* render_opts, const GameContext* context);
 void render_game_mode_choice(const UiOptions* render_opts, const GameContext* context);
+void unload_render_layers(void);
+void render_loading_screen(float progress, const UiOptions* render_opts);
+void render_memory_stats(void);
 Rectangle calc_music_icon_rect(const GameContext* context, const GameResources* resources);
-void do_game_start_transition(const GameResources* resources, const UiOptions* render_opts,
-                                  GameContext* context);
-void do_game_over_transition(
+void render_game_start_transition(const GameResources* resources, const UiOptions* render_opts,
+                                  const GameContext* context);
+void render_game_over_transition(
  const GameResources* resources,
  const UiOptions* render_opts,
- GameContext* context
+ const GameContext* context
 );
 
 #endif //RENDER_H
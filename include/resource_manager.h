@@ -0,0 +1,28 @@
+#ifndef RESOURCE_MANAGER_H
+#define RESOURCE_MANAGER_H
+
+#include <common.h>
+
+// Bytes kept resident before the least recently used unreferenced resources are evicted.
+// Fits both 700x190 RGBA instruction images (~1 MiB) and the models with room to spare,
+// so revisiting a screen never decodes its images again
+#define RESOURCE_BUDGET_DEFAULT (4 * 1024 * 1024)
+
+typedef enum {
+    RES_INSTRUCTIONS_1,
+    RES_INSTRUCTIONS_2,
+    RES_NEURAL_NETWORK,
+    RES_BAYES_MODEL,
+    RES_COUNT
+} ResourceId;
+
+void init_resource_manager(size_t budget_bytes);
+void cleanup_resource_manager(void);
+AiModels* resource_models(void);
+void acquire_resource(ResourceId id);
+void release_resource(ResourceId id);
+void set_resource_scope(GameState state, GameMode mode);
+Texture2D get_texture_resource(ResourceId id);
+size_t resident_resource_bytes(void);
+
+#endif //RESOURCE_MANAGER_H
@@ -0,0 +1,42 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stdint.h>
+
+#define ENGINE_SERVER_DEFAULT_SOCKET "/tmp/tic_tac_toe_engine.sock"
+
+/**
+ * Wire format of the engine server, all fields are in host byte order since
+ * the socket never leaves the machine. Clients may write any number of requests
+ * back to back without waiting; every response echoes its request_id and
+ * responses are sent in completion order.
+ */
+typedef enum {
+    ENGINE_STATUS_OK = 0,
+    ENGINE_STATUS_NO_MOVE = 1,     // Board is full or already decided
+    ENGINE_STATUS_BAD_REQUEST = 2  // Overlapping boards, unknown engine or player
+} EngineStatus;
+
+typedef struct {
+    uint32_t request_id;
+    uint16_t x_board;
+    uint16_t o_board;
+    uint8_t engine;          // GameMode of the engine to use, TWO_PLAYER is rejected
+    uint8_t computer_player; // PLAYER_X or PLAYER_O, the side to move
+    uint8_t reserved[2];
+} EngineRequest;
+
+typedef struct {
+    uint32_t request_id;
+    int8_t move;             // Cell index 0-8, -1 when there is no move
+    uint8_t status;          // EngineStatus
+    int16_t score_milli;     // Engine score scaled by 1000
+    uint32_t latency_us;     // Time from request decode to response queued
+} EngineResponse;
+
+_Static_assert(sizeof(EngineRequest) == 12, "EngineRequest must stay 12 bytes on the wire");
+_Static_assert(sizeof(EngineResponse) == 12, "EngineResponse must stay 12 bytes on the wire");
+
+int run_engine_server(const char* socket_path);
+
+#endif //SERVER_H
@@ -0,0 +1,39 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+
+#include <common.h>
+
+#define SPECTATOR_DEFAULT_BOARDS 64
+#define SPECTATOR_MAX_BOARDS 1024
+#define SPECTATOR_THREADS 4
+
+// Time between two moves of a match, and how long a finished board stays up
+#define SPECTATOR_MOVE_SECONDS 0.4
+#define SPECTATOR_RESULT_SECONDS 2.0
+
+/**
+ * Immutable snapshot of one board, published as a single 32-bit word:
+ * bits 0-8 X cells, bits 9-17 O cells, bits 18-19 SpectatorStatus,
+ * bits 20-23 winning pattern (15 for none), bits 24-31 game counter
+ */
+typedef uint32_t BoardSnapshot;
+
+typedef enum {
+    SPECTATOR_PLAYING = 0,
+    SPECTATOR_X_WON = 1,
+    SPECTATOR_O_WON = 2,
+    SPECTATOR_DRAW = 3
+} SpectatorStatus;
+
+#define SNAPSHOT_X(s) ((uint16_t)((s) & 0x1FF))
+#define SNAPSHOT_O(s) ((uint16_t)((s) >> 9 & 0x1FF))
+#define SNAPSHOT_STATUS(s) ((SpectatorStatus)((s) >> 18 & 0x3))
+#define SNAPSHOT_PATTERN(s) ((int)((s) >> 20 & 0xF))
+
+SpectatorWall* init_spectator_wall(const AiModels* models, int board_count);
+void cleanup_spectator_wall(SpectatorWall* wall);
+int spectator_board_count(const SpectatorWall* wall);
+void spectator_snapshots(const SpectatorWall* wall, BoardSnapshot* out);
+void render_spectator_wall(const SpectatorWall* wall, const UiOptions* render_opts);
+
+#endif //SPECTATOR_H
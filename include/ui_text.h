@@ -0,0 +1,20 @@
+#ifndef UI_TEXT_H
+#define UI_TEXT_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+// TTF rendered through a signed distance field atlas, the default font is used if it fails to load
+#define UI_FONT_PATH "assets/ui_font.ttf"
+#define UI_FONT_BASE_SIZE 64
+
+void load_ui_font(void);
+void unload_ui_font(void);
+bool ui_font_is_sdf(void);
+int measure_ui_text(const char* text, int font_size);
+void draw_ui_text(const char* text, int x, int y, int font_size, Color color);
+
+void draw_x_symbol(Rectangle cell, Color color);
+void draw_o_symbol(Rectangle cell, Color color);
+
+#endif //UI_TEXT_H
@@ -0,0 +1,59 @@
+#ifndef UI_TREE_H
+#define UI_TREE_H
+
+#include <buttons.h>
+
+// Uniform grid over the window used to find the widgets under a point
+#define HIT_GRID_COLS 8
+#define HIT_GRID_ROWS 8
+
+typedef enum {
+    UI_SCREEN_MAIN_MENU,
+    UI_SCREEN_GAME_MODE,
+    UI_SCREEN_EXIT,
+    UI_SCREEN_INSTRUCTIONS,
+    UI_SCREEN_GAME_OVER,
+    UI_SCREEN_IN_GAME,
+    UI_SCREEN_COUNT
+} UiScreenId;
+
+// A button widget, owns the rectangle and geometry its Button points at
+typedef struct {
+    Button* button;
+    Rectangle bounds;
+    ButtonGeometry geometry;
+} UiNode;
+
+typedef struct {
+    UiNode nodes[MAX_BUTTON_GROUP_SIZE];
+    int node_count;
+    int per_row;
+    int hovered; // Index of the hovered node, -1 for none
+
+    // Indices of the nodes overlapping each hit grid cell
+    uint8_t cells[HIT_GRID_ROWS][HIT_GRID_COLS][MAX_BUTTON_GROUP_SIZE];
+    uint8_t cell_counts[HIT_GRID_ROWS][HIT_GRID_COLS];
+    float cell_width;
+    float cell_height;
+} UiScreen;
+
+typedef struct {
+    UiScreen screens[UI_SCREEN_COUNT];
+    uint32_t layout_generation;
+
+    // Hover is only resolved again when one of these changes
+    UiScreenId hover_screen;
+    Vector2 hover_mouse;
+    uint32_t hover_generation;
+
+    bool dirty; // Something visible in the tree changed since the last drawn frame
+} UiTree;
+
+void layout_ui_tree(uint32_t generation);
+UiScreenId ui_screen_for_state(GameState state);
+bool update_ui_hover(UiScreenId screen, Vector2 mouse_pos);
+Button* ui_hit_test(UiScreenId screen, Vector2 point);
+bool ui_tree_dirty(void);
+void clear_ui_tree_dirty(void);
+
+#endif //UI_TREE_H
@@ -0,0 +1,21 @@
+#ifndef UPDATE_H
+#define UPDATE_H
+
+#include <game.h>
+
+// Game logic advances in fixed steps, independent of how often frames are drawn
+#define SIM_TICK_SECONDS (1.0 / 60.0)
+#define MAX_SIM_TICKS_PER_UPDATE 8
+#define TRANSITION_SECONDS 1.0
+
+typedef struct {
+    double last_time;
+    double accumulator;
+} SimClock;
+
+void init_sim_clock(SimClock* clock);
+void process_input(const GameResources* resources, GameContext* context);
+void simulate_tick(const GameResources* resources, GameContext* context, double dt);
+int update_game(SimClock* clock, const GameResources* resources, GameContext* context);
+
+#endif //UPDATE_H
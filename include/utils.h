@@ -15,7 +15,8 @@ Coords calculate_centered_text_xy(
     float ref_x,
     float ref_y,
     float ref_width,
-    float ref_height
+    float ref_height,
+    MemoCache* cache
 );
 
 Coords calculate_text_xy_offset(
@@ -29,6 +30,8 @@ Coords calculate_text_xy_offset(
     float horizontal_offset_percent, MemoCache* cache
 );
 
+int measure_text_cached(const char* message, int font_size, MemoCache* cache);
+
 int count_trailing_zeros(uint16_t x);
 
 #endif //UTILS_H
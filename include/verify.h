@@ -0,0 +1,6 @@
+#ifndef VERIFY_H
+#define VERIFY_H
+
+int run_engine_verification(void);
+
+#endif //VERIFY_H
@@ -0,0 +1,387 @@
+/**
+ * @file ai_worker.c
+ * @brief Background thread running the computer's search off the render thread
+ *
+ * The main loop submits a snapshot of the board and keeps rendering, then picks the
+ * result up with ai_worker_poll() once the search finishes. Every submission gets a
+ * generation number so results of cancelled searches are silently dropped.
+ *
+ * While the human is thinking the worker ponders: it searches the computer's answer
+ * to each likely human reply, so the matching submission is answered from the cache.
+ */
+#include <ai_worker.h>
+#include <arena.h>
+#include <computer.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define MAX_PONDER_REPLIES 9
+
+typedef struct {
+    uint16_t x_board;
+    uint16_t o_board;
+    EvalResult result;
+} PonderEntry;
+
+struct AiWorker {
+    const AiModels* models;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stopping;
+
+    // Request handoff, guarded by lock
+    bool has_request;
+    uint64_t generation;
+    uint16_t request_x_board;
+    uint16_t request_o_board;
+    GameMode request_mode;
+    player_t request_player_1;
+    bool request_stats;
+
+    // Future, guarded by lock
+    bool pending;
+    bool result_ready;
+    EvalResult result;
+    SearchStats stats;
+
+    // Pondering on the human's turn, guarded by lock
+    bool has_ponder;
+    bool ponder_ordered;
+    uint16_t ponder_x_board;
+    uint16_t ponder_o_board;
+    GameMode ponder_mode;
+    player_t ponder_player_1;
+    int ponder_replies[MAX_PONDER_REPLIES];
+    int ponder_reply_count;
+    int ponder_next;
+    PonderEntry ponder_cache[MAX_PONDER_REPLIES];
+    int ponder_cache_count;
+
+    // Polled by the search so a cancelled request stops early
+    atomic_bool abort_search;
+};
+
+/**
+ * @brief Orders the human's legal replies from most to least likely
+ *
+ * @param worker Worker holding the pondered position, lock must be held
+ *
+ * @details
+ * Replies that block a computer win come first, then the centre, corners and
+ * finally edges. Replies that end the game are not pondered, there is no answer to
+ * prepare. Runs on the worker thread, which owns its thread-local board.
+ */
+static void order_ponder_replies(AiWorker* worker)
+{
+    const player_t human = worker->ponder_player_1;
+    const player_t computer = human == PLAYER_X ? PLAYER_O : PLAYER_X;
+    int priorities[MAX_PONDER_REPLIES];
+    worker->ponder_reply_count = 0;
+
+    for (int move = 0; move < BOARD_SIZE * BOARD_SIZE; move++)
+    {
+        x_board = worker->ponder_x_board;
+        o_board = worker->ponder_o_board;
+        if (!is_cell_empty(move / 3, move % 3)) continue;
+
+        int priority = move == 4 ? 20 : move % 2 == 0 ? 10 : 0;
+
+        set_cell(move / 3, move % 3, computer);
+        if (check_win(computer) != -1) priority = 30;
+
+        x_board = worker->ponder_x_board;
+        o_board = worker->ponder_o_board;
+        set_cell(move / 3, move % 3, human);
+        if (check_win(human) != -1 || check_draw()) continue; // Game over, no answer to ponder
+
+        // Insertion sort, stable so equal priorities keep board order
+        int i = worker->ponder_reply_count++;
+        while (i > 0 && priorities[i - 1] < priority)
+        {
+            priorities[i] = priorities[i - 1];
+            worker->ponder_replies[i] = worker->ponder_replies[i - 1];
+            i--;
+        }
+        priorities[i] = priority;
+        worker->ponder_replies[i] = move;
+    }
+    worker->ponder_ordered = true;
+}
+
+static void* ai_worker_main(void* arg)
+{
+    AiWorker* worker = arg;
+    set_search_abort_flag(&worker->abort_search);
+
+    pthread_mutex_lock(&worker->lock);
+    for (;;)
+    {
+        while (!worker->has_request && !worker->has_ponder && !worker->stopping)
+        {
+            pthread_cond_wait(&worker->wake, &worker->lock);
+        }
+        if (worker->stopping) break;
+
+        const uint64_t generation = worker->generation;
+        GameContext context = {
+            .selected_game_mode = worker->request_mode,
+            .computer_enabled = true,
+            .player_1 = worker->request_player_1,
+        };
+        bool pondering = false;
+        bool collect_stats = false;
+
+        if (worker->has_request)
+        {
+            // Boards are thread-local, so the search never touches the board being rendered
+            x_board = worker->request_x_board;
+            o_board = worker->request_o_board;
+            collect_stats = worker->request_stats;
+            worker->has_request = false;
+        }
+        else
+        {
+            // Ponder one reply at a time so a real request is never kept waiting long
+            if (!worker->ponder_ordered) order_ponder_replies(worker);
+            if (worker->ponder_next >= worker->ponder_reply_count)
+            {
+                worker->has_ponder = false;
+                continue;
+            }
+            const int reply = worker->ponder_replies[worker->ponder_next++];
+
+            context.selected_game_mode = worker->ponder_mode;
+            context.player_1 = worker->ponder_player_1;
+            x_board = worker->ponder_x_board;
+            o_board = worker->ponder_o_board;
+            set_cell(reply / 3, reply % 3, context.player_1);
+            pondering = true;
+        }
+        const uint16_t searched_x_board = x_board;
+        const uint16_t searched_o_board = o_board;
+        atomic_store(&worker->abort_search, false);
+        pthread_mutex_unlock(&worker->lock);
+
+        SearchStats stats;
+        const EvalResult result = choose_computer_move(&context, worker->models, collect_stats ? &stats : NULL);
+
+        pthread_mutex_lock(&worker->lock);
+        if (generation != worker->generation) continue; // Cancelled or superseded
+
+        if (pondering)
+        {
+            PonderEntry* entry = &worker->ponder_cache[worker->ponder_cache_count++];
+            entry->x_board = searched_x_board;
+            entry->o_board = searched_o_board;
+            entry->result = result;
+        }
+        else if (worker->pending)
+        {
+            worker->result = result;
+            worker->stats = collect_stats ? stats : (SearchStats){0};
+            worker->result_ready = true;
+        }
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+
+/**
+ * @brief Drops any pondering in progress and its cached answers, lock must be held
+ */
+static void reset_ponder(AiWorker* worker)
+{
+    worker->has_ponder = false;
+    worker->ponder_cache_count = 0;
+}
+
+/**
+ * @brief Starts the AI worker thread
+ *
+ * @param models Models shared with the search, must outlive the worker
+ * @return Pointer to the worker, or NULL on failure
+ */
+AiWorker* init_ai_worker(const AiModels* models)
+{
+    AiWorker* worker = arena_alloc(&session_arena, MEM_AI, sizeof(AiWorker));
+    if (!worker) return NULL;
+
+    worker->models = models;
+    pthread_mutex_init(&worker->lock, NULL);
+    pthread_cond_init(&worker->wake, NULL);
+    atomic_init(&worker->abort_search, false);
+
+    if (pthread_create(&worker->thread, NULL, ai_worker_main, worker) != 0)
+    {
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        return NULL;
+    }
+    return worker;
+}
+
+/**
+ * @brief Cancels any search in progress and stops the thread
+ *
+ * @details The worker's memory belongs to the session arena
+ *
+ * @param worker Pointer to the AiWorker, may be NULL
+ */
+void cleanup_ai_worker(AiWorker* worker)
+{
+    if (!worker) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->stopping = true;
+    atomic_store(&worker->abort_search, true);
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+
+    pthread_join(worker->thread, NULL);
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+}
+
+/**
+ * @brief Requests the computer's move for the current board
+ *
+ * @param worker Pointer to the AiWorker
+ * @param context Current game context, the difficulty and sides are copied
+ *
+ * @details
+ * A snapshot of the calling thread's board is taken, so the caller is free to keep
+ * rendering it. Any earlier request that has not been collected is superseded.
+ * If the position was pondered the result is ready immediately.
+ */
+void ai_worker_submit(AiWorker* worker, const GameContext* context)
+{
+    pthread_mutex_lock(&worker->lock);
+    worker->generation++;
+
+    if (worker->ponder_mode == context->selected_game_mode && worker->ponder_player_1 == context->player_1)
+    {
+        for (int i = 0; i < worker->ponder_cache_count; i++)
+        {
+            const PonderEntry* entry = &worker->ponder_cache[i];
+            if (entry->x_board == x_board && entry->o_board == o_board)
+            {
+                worker->result = entry->result;
+                worker->stats = (SearchStats){.tt_hits = 1};
+                worker->result_ready = true;
+                worker->pending = true;
+                worker->has_request = false;
+                reset_ponder(worker);
+                atomic_store(&worker->abort_search, true);
+                pthread_mutex_unlock(&worker->lock);
+                TraceLog(LOG_DEBUG, "Ponder hit, move %d served from cache", entry->result.move);
+                return;
+            }
+        }
+    }
+    reset_ponder(worker);
+
+    worker->request_x_board = x_board;
+    worker->request_o_board = o_board;
+    worker->request_mode = context->selected_game_mode;
+    worker->request_player_1 = context->player_1;
+    worker->request_stats = context->search_stats_enabled;
+    worker->has_request = true;
+    worker->pending = true;
+    worker->result_ready = false;
+    atomic_store(&worker->abort_search, true); // Stop a superseded search early
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+ * @brief Collects the result of the last submitted request
+ *
+ * @param worker Pointer to the AiWorker
+ * @param result Receives the computer's move when ready
+ * @param stats Receives the search statistics when ready, zeroed unless the request enabled them, may be NULL
+ * @return true exactly once per request, when its result becomes available
+ */
+bool ai_worker_poll(AiWorker* worker, EvalResult* result, SearchStats* stats)
+{
+    pthread_mutex_lock(&worker->lock);
+    const bool ready = worker->result_ready;
+    if (ready)
+    {
+        *result = worker->result;
+        if (stats) *stats = worker->stats;
+        worker->result_ready = false;
+        worker->pending = false;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return ready;
+}
+
+/**
+ * @brief Checks if a request is waiting for its result
+ *
+ * @param worker Pointer to the AiWorker, may be NULL
+ * @return true while the computer is thinking
+ */
+bool ai_worker_busy(AiWorker* worker)
+{
+    if (!worker) return false;
+
+    pthread_mutex_lock(&worker->lock);
+    const bool pending = worker->pending;
+    pthread_mutex_unlock(&worker->lock);
+    return pending;
+}
+
+/**
+ * @brief Abandons the outstanding request, its result will never be returned
+ *
+ * @param worker Pointer to the AiWorker, may be NULL
+ */
+void ai_worker_cancel(AiWorker* worker)
+{
+    if (!worker) return;
+
+    pthread_mutex_lock(&worker->lock);
+    worker->generation++;
+    worker->has_request = false;
+    worker->pending = false;
+    worker->result_ready = false;
+    reset_ponder(worker);
+    atomic_store(&worker->abort_search, true);
+    pthread_mutex_unlock(&worker->lock);
+}
+
+/**
+ * @brief Starts pondering the computer's answers while the human is on move
+ *
+ * @param worker Pointer to the AiWorker
+ * @param context Current game context, pondering is skipped unless enabled for a computer game
+ *
+ * @details
+ * Takes a snapshot of the calling thread's board, which must have the human to move.
+ * The answers are cached until the next submission, cancel or ponder.
+ */
+void ai_worker_ponder(AiWorker* worker, const GameContext* context)
+{
+    if (!worker || !context->pondering_enabled || !context->computer_enabled) return;
+
+    pthread_mutex_lock(&worker->lock);
+    if (!worker->pending)
+    {
+        worker->generation++;
+        reset_ponder(worker);
+        worker->ponder_x_board = x_board;
+        worker->ponder_o_board = o_board;
+        worker->ponder_mode = context->selected_game_mode;
+        worker->ponder_player_1 = context->player_1;
+        worker->ponder_ordered = false;
+        worker->ponder_reply_count = 0;
+        worker->ponder_next = 0;
+        worker->has_ponder = true;
+        pthread_cond_signal(&worker->wake);
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
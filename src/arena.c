@@ -0,0 +1,159 @@
+/**
+ * @file arena.c
+ * @brief Session and frame arenas
+ *
+ * Allocations are carved from large blocks and never freed one by one. The session
+ * arena is torn down once at exit. The frame arena is reset after every drawn frame;
+ * when a frame needed more than one block, the blocks are merged into one large
+ * enough for it, so steady-state frames allocate nothing from the heap.
+ */
+#include <arena.h>
+#include <raylib.h>
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t size;
+    size_t used;
+    _Alignas(ARENA_ALIGNMENT) unsigned char data[];
+};
+
+Arena session_arena = {.name = "session", .block_size = SESSION_ARENA_BLOCK_SIZE};
+Arena frame_arena = {.name = "frame", .block_size = FRAME_ARENA_BLOCK_SIZE};
+
+#define ALIGN_UP(size) (((size) + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1))
+
+static ArenaBlock* new_block(const size_t size)
+{
+    ArenaBlock* block = malloc(sizeof(ArenaBlock) + size);
+    if (!block) return NULL;
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+/**
+ * @brief Allocates zeroed memory aligned to ARENA_ALIGNMENT
+ *
+ * @param subsystem Subsystem the memory is accounted to until the arena is reset
+ * @return Pointer to the memory, NULL if a new block could not be allocated
+ */
+void* arena_alloc(Arena* arena, const MemSubsystem subsystem, size_t size)
+{
+    size = ALIGN_UP(size ? size : 1);
+
+    ArenaBlock* block = arena->blocks;
+    if (!block || block->size - block->used < size)
+    {
+        block = new_block(size > arena->block_size ? size : arena->block_size);
+        if (!block)
+        {
+            TraceLog(LOG_ERROR, "Arena %s: out of memory allocating %zu bytes", arena->name, size);
+            return NULL;
+        }
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void* memory = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    arena->used_by[subsystem] += size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    track_alloc(subsystem, MEM_HEAP, size);
+
+    memset(memory, 0, size);
+    return memory;
+}
+
+/**
+ * @brief Allocates a zeroed array
+ */
+void* arena_calloc(Arena* arena, const MemSubsystem subsystem, const size_t count, const size_t size)
+{
+    if (size && count > SIZE_MAX / size) return NULL;
+    return arena_alloc(arena, subsystem, count * size);
+}
+
+/**
+ * @brief Formats a string into the arena
+ *
+ * @return The string, "" if it could not be allocated
+ */
+char* arena_printf(Arena* arena, const MemSubsystem subsystem, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    va_list measure;
+    va_copy(measure, args);
+    const int length = vsnprintf(NULL, 0, format, measure);
+    va_end(measure);
+
+    char* text = length >= 0 ? arena_alloc(arena, subsystem, (size_t)length + 1) : NULL;
+    if (!text)
+    {
+        va_end(args);
+        return "";
+    }
+    vsnprintf(text, (size_t)length + 1, format, args);
+    va_end(args);
+    return text;
+}
+
+/**
+ * @brief Returns the arena's accounted bytes to their subsystems
+ */
+static void release_accounting(Arena* arena)
+{
+    for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++)
+    {
+        track_free(i, MEM_HEAP, arena->used_by[i]);
+        arena->used_by[i] = 0;
+    }
+    arena->used = 0;
+}
+
+/**
+ * @brief Releases every allocation, keeping the memory for reuse
+ *
+ * @details Blocks are merged into one that fits everything the arena held, so the
+ * same workload fits without new blocks next time
+ */
+void reset_arena(Arena* arena)
+{
+    ArenaBlock* block = arena->blocks;
+    if (block && block->next)
+    {
+        size_t total = 0;
+        for (const ArenaBlock* b = block; b; b = b->next) total += b->size;
+        free_arena(arena);
+        arena->blocks = new_block(total);
+    }
+    else if (block)
+    {
+        block->used = 0;
+    }
+    release_accounting(arena);
+}
+
+/**
+ * @brief Frees every block of the arena
+ */
+void free_arena(Arena* arena)
+{
+    ArenaBlock* block = arena->blocks;
+    while (block)
+    {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->blocks = NULL;
+    release_accounting(arena);
+}
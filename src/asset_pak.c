@@ -0,0 +1,259 @@
+/**
+ * @file asset_pak.c
+ * @brief Read-only access to the packed asset archive
+ *
+ * The pak is either linked into the executable (EMBED_ASSET_PAK) or memory mapped
+ * from assets.pak next to the executable, falling back to the working directory.
+ * Lookups return pointers into the mapping, so loaders decode without copying the
+ * file first. Assets missing from the pak, or a missing pak, fall back to the loose
+ * files under assets/.
+ */
+#include <asset_pak.h>
+#include <raylib.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef EMBED_ASSET_PAK
+// ASSET_PAK_PATH is set by CMake to the pak built by the asset_packer target
+#define PAK_STRINGIFY_(x) #x
+#define PAK_STRINGIFY(x) PAK_STRINGIFY_(x)
+#define PAK_SYMBOL(name) PAK_STRINGIFY(__USER_LABEL_PREFIX__) #name
+
+#ifdef __APPLE__
+#define PAK_SECTION ".const_data\n"
+#define PAK_SECTION_END ".text\n"
+#else
+#define PAK_SECTION ".pushsection .rodata\n"
+#define PAK_SECTION_END ".popsection\n"
+#endif
+
+__asm__(
+    PAK_SECTION
+    ".balign " PAK_STRINGIFY(ASSET_PAK_ALIGNMENT) "\n"
+    ".globl " PAK_SYMBOL(embedded_asset_pak) "\n"
+    PAK_SYMBOL(embedded_asset_pak) ":\n"
+    ".incbin \"" ASSET_PAK_PATH "\"\n"
+    ".globl " PAK_SYMBOL(embedded_asset_pak_end) "\n"
+    PAK_SYMBOL(embedded_asset_pak_end) ":\n"
+    PAK_SECTION_END);
+
+extern const unsigned char embedded_asset_pak[];
+extern const unsigned char embedded_asset_pak_end[];
+#endif
+
+typedef enum {
+    PAK_NONE,
+    PAK_EMBEDDED,
+    PAK_MAPPED,
+    PAK_FILE_DATA // Read into memory where mmap is not available
+} PakSource;
+
+static struct {
+    PakSource source;
+    const unsigned char* data;
+    size_t size;
+    const AssetPakEntry* entries;
+    uint32_t entry_count;
+} asset_pak = {0};
+
+/**
+ * @brief Checks the header and that every entry lies inside the pak
+ */
+static bool validate_pak(const unsigned char* data, const size_t size)
+{
+    if (size < sizeof(AssetPakHeader)) return false;
+
+    const AssetPakHeader* header = (const AssetPakHeader*)data;
+    if (header->magic != ASSET_PAK_MAGIC || header->version != ASSET_PAK_VERSION) return false;
+    if (header->entry_count > (size - sizeof(AssetPakHeader)) / sizeof(AssetPakEntry)) return false;
+
+    const AssetPakEntry* entries = (const AssetPakEntry*)(data + sizeof(AssetPakHeader));
+    for (uint32_t i = 0; i < header->entry_count; i++)
+    {
+        if (memchr(entries[i].name, '\0', ASSET_PAK_NAME_LEN) == NULL) return false;
+        if (entries[i].offset > size || entries[i].size > size - entries[i].offset) return false;
+        if (entries[i].size > INT32_MAX) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps or reads the pak at path
+ *
+ * @return true if the pak is now open
+ */
+static bool load_pak_file(const char* path)
+{
+#ifdef _WIN32
+    int file_size = 0;
+    unsigned char* file_data = FileExists(path) ? LoadFileData(path, &file_size) : NULL;
+    if (file_data == NULL) return false;
+
+    asset_pak.source = PAK_FILE_DATA;
+    asset_pak.data = file_data;
+    asset_pak.size = (size_t)file_size;
+    return true;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED)
+    {
+        TraceLog(LOG_WARNING, "Failed to map %s", path);
+        return false;
+    }
+
+    asset_pak.source = PAK_MAPPED;
+    asset_pak.data = mapping;
+    asset_pak.size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+/**
+ * @brief Opens the asset pak, embedded or from disk
+ *
+ * @return true if a valid pak is open, false if assets are read from assets/
+ *
+ * @details Call once on the main thread before any asset is loaded, lookups are
+ * read-only afterwards and safe from any thread
+ */
+bool open_asset_pak(void)
+{
+    if (asset_pak.source != PAK_NONE) return true;
+
+#ifdef EMBED_ASSET_PAK
+    asset_pak.source = PAK_EMBEDDED;
+    asset_pak.data = embedded_asset_pak;
+    asset_pak.size = (size_t)(embedded_asset_pak_end - embedded_asset_pak);
+#else
+    if (!load_pak_file(TextFormat("%s%s", GetApplicationDirectory(), ASSET_PAK_FILE)) &&
+        !load_pak_file(ASSET_PAK_FILE))
+    {
+        TraceLog(LOG_INFO, "No %s, loading assets from the assets directory", ASSET_PAK_FILE);
+        return false;
+    }
+#endif
+
+    if (!validate_pak(asset_pak.data, asset_pak.size))
+    {
+        TraceLog(LOG_WARNING, "%s is corrupt or from another version, ignoring it", ASSET_PAK_FILE);
+        close_asset_pak();
+        return false;
+    }
+
+    const AssetPakHeader* header = (const AssetPakHeader*)asset_pak.data;
+    asset_pak.entries = (const AssetPakEntry*)(asset_pak.data + sizeof(AssetPakHeader));
+    asset_pak.entry_count = header->entry_count;
+    TraceLog(LOG_INFO, "Asset pak opened, %u entries, %zu bytes", asset_pak.entry_count, asset_pak.size);
+    return true;
+}
+
+/**
+ * @brief Releases the pak
+ *
+ * @details Music streams decode from the pak, unload them first
+ */
+void close_asset_pak(void)
+{
+    switch (asset_pak.source)
+    {
+    case PAK_MAPPED:
+#ifndef _WIN32
+        munmap((void*)asset_pak.data, asset_pak.size);
+#endif
+        break;
+    case PAK_FILE_DATA:
+        UnloadFileData((unsigned char*)asset_pak.data);
+        break;
+    case PAK_EMBEDDED:
+    case PAK_NONE:
+        break;
+    }
+    memset(&asset_pak, 0, sizeof(asset_pak));
+}
+
+static int compare_entry_name(const void* key, const void* entry)
+{
+    return strcmp(key, ((const AssetPakEntry*)entry)->name);
+}
+
+/**
+ * @brief Looks up an asset in the pak
+ *
+ * @param path Path the asset has under the source tree, e.g. "assets/main1.png"
+ * @param size Receives the size in bytes
+ * @return Pointer to the asset bytes inside the pak, NULL if it is not packed
+ */
+const unsigned char* find_pak_asset(const char* path, int* size)
+{
+    if (asset_pak.entry_count == 0) return NULL;
+
+    const AssetPakEntry* entry =
+        bsearch(path, asset_pak.entries, asset_pak.entry_count, sizeof(AssetPakEntry), compare_entry_name);
+    if (!entry) return NULL;
+
+    *size = (int)entry->size;
+    return asset_pak.data + entry->offset;
+}
+
+/**
+ * @brief Opens an asset for sequential reading
+ *
+ * @param reader Reader to initialise
+ * @param path Path of the asset, e.g. "assets/nn_weights.dat"
+ * @return true on success
+ */
+bool open_asset_reader(AssetReader* reader, const char* path)
+{
+    memset(reader, 0, sizeof(AssetReader));
+
+    int size = 0;
+    reader->data = find_pak_asset(path, &size);
+    if (reader->data)
+    {
+        reader->size = (size_t)size;
+        return true;
+    }
+
+    reader->file = fopen(path, "rb");
+    return reader->file != NULL;
+}
+
+/**
+ * @brief Reads the next bytes of the asset
+ *
+ * @return Number of bytes read, less than requested at the end of the asset
+ */
+size_t read_asset(AssetReader* reader, void* destination, size_t bytes)
+{
+    if (reader->file) return fread(destination, 1, bytes, reader->file);
+
+    if (bytes > reader->size - reader->position) bytes = reader->size - reader->position;
+    memcpy(destination, reader->data + reader->position, bytes);
+    reader->position += bytes;
+    return bytes;
+}
+
+void close_asset_reader(AssetReader* reader)
+{
+    if (reader->file) fclose(reader->file);
+    memset(reader, 0, sizeof(AssetReader));
+}
@@ -0,0 +1,306 @@
+/**
+ * @file atlas.c
+ * @brief Packs the UI images into a single texture
+ *
+ * All sprites live in one texture, so every screen binds it once and raylib batches
+ * the sprite quads into a single draw call. Each sprite is resampled to the size it
+ * is displayed at for the current window, so it is drawn 1:1 and the texture holds
+ * no texels that are never sampled. Sprites that depend on the window size are
+ * resampled again once a resize has settled; while the window is being dragged the
+ * current sprites are drawn scaled instead of being re-decoded every frame.
+ */
+#include <atlas.h>
+#include <loader.h>
+#include <mem_stats.h>
+
+// GetTime() of the last resize not yet applied to the atlas, negative when none is pending
+static double resize_pending_since = -1.0;
+
+static const char* SPRITE_PATHS[SPRITE_COUNT] = {
+    [SPRITE_MAIN_MENU] = "assets/main1.png",
+    [SPRITE_MUSIC_ON] = "assets/music_on.png",
+    [SPRITE_MUSIC_OFF] = "assets/music_off.png"
+};
+
+/**
+ * @brief Returns the asset path of a sprite's source image
+ */
+const char* sprite_path(const SpriteId sprite)
+{
+    return SPRITE_PATHS[sprite];
+}
+
+/**
+ * @brief Computes the size a sprite is displayed at
+ *
+ * @param sprite Sprite to size
+ * @param source_width Width of the source image
+ * @param source_height Height of the source image
+ * @param screen_width Window width
+ * @param screen_height Window height
+ * @return Display size in whole pixels
+ */
+static Vector2 sprite_display_size(const SpriteId sprite, const int source_width, const int source_height,
+                                   const int screen_width, const int screen_height)
+{
+    switch (sprite)
+    {
+    case SPRITE_MAIN_MENU:
+        return (Vector2){(float)(int)((float)screen_width * MENU_IMAGE_SCALE),
+                         (float)(int)((float)screen_height * MENU_IMAGE_SCALE)};
+    case SPRITE_MUSIC_ON:
+    case SPRITE_MUSIC_OFF:
+        return (Vector2){(float)(int)((float)source_width * MUSIC_ICON_SCALE),
+                         (float)(int)((float)source_height * MUSIC_ICON_SCALE)};
+    default:
+        return (Vector2){(float)source_width, (float)source_height};
+    }
+}
+
+/**
+ * @brief Resamples a decoded sprite image to its display size
+ *
+ * @param image Image to resample in place
+ * @param sprite Sprite the image belongs to
+ * @param screen_width Window width
+ * @param screen_height Window height
+ *
+ * @details CPU only, safe to call from a worker thread
+ */
+void resample_sprite_image(Image* image, const SpriteId sprite, const int screen_width, const int screen_height)
+{
+    if (image->data == NULL) return;
+
+    const Vector2 size = sprite_display_size(sprite, image->width, image->height, screen_width, screen_height);
+    if ((int)size.x < 1 || (int)size.y < 1) return;
+    if ((int)size.x != image->width || (int)size.y != image->height)
+    {
+        ImageResize(image, (int)size.x, (int)size.y);
+    }
+}
+
+/**
+ * @brief Rebuilds the atlas if a sprite's display size changed with the window size
+ *
+ * @param atlas Pointer to the atlas, replaced when rebuilt
+ * @param screen_width New window width
+ * @param screen_height New window height
+ * @return true if the atlas was rebuilt
+ *
+ * @details Source images are decoded again from the asset pak, so nothing but the
+ * atlas stays resident. Requires an active window.
+ */
+bool refresh_texture_atlas(TextureAtlas* atlas, const int screen_width, const int screen_height)
+{
+    // Only the menu image follows the window size
+    const Vector2 wanted = sprite_display_size(SPRITE_MAIN_MENU, 0, 0, screen_width, screen_height);
+    const Vector2 current = sprite_size(atlas, SPRITE_MAIN_MENU);
+    if (wanted.x == current.x && wanted.y == current.y) return false;
+    if ((int)wanted.x < 1 || (int)wanted.y < 1) return false;
+
+    Image images[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        images[i] = load_image_asset(SPRITE_PATHS[i]);
+        resample_sprite_image(&images[i], i, screen_width, screen_height);
+    }
+
+    unload_texture_atlas(atlas);
+    *atlas = build_texture_atlas(images);
+
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        UnloadImage(images[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Rebuilds the atlas once the window size has been stable for ATLAS_REFRESH_DELAY_SECONDS
+ *
+ * @param atlas Pointer to the atlas, replaced when rebuilt
+ * @param resized true if the window was resized this frame
+ * @return true if the atlas was rebuilt, the frame has to be redrawn
+ *
+ * @details Call once per loop iteration. Until the rebuild, draw window sized
+ * sprites at sprite_draw_size() so the old ones are scaled to fit.
+ */
+bool update_texture_atlas(TextureAtlas* atlas, const bool resized)
+{
+    const double now = GetTime();
+    if (resized) resize_pending_since = now;
+    if (resize_pending_since < 0.0 || now - resize_pending_since < ATLAS_REFRESH_DELAY_SECONDS) return false;
+
+    resize_pending_since = -1.0;
+    return refresh_texture_atlas(atlas, GetScreenWidth(), GetScreenHeight());
+}
+
+/**
+ * @brief Packs images into one image using shelf packing
+ *
+ * @param images One image per SpriteId, not modified
+ * @param sprites Receives the sub-rectangle of every sprite
+ * @return Packed image, the caller unloads it
+ *
+ * @details Images are placed tallest first, left to right, on shelves at most
+ * ATLAS_MAX_WIDTH wide. CPU only, safe to call from a worker thread.
+ */
+Image pack_texture_atlas(const Image images[SPRITE_COUNT], Rectangle sprites[SPRITE_COUNT])
+{
+    // Sort sprite ids by descending height so shelves waste little space
+    int order[SPRITE_COUNT];
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        int j = i;
+        while (j > 0 && images[order[j - 1]].height < images[i].height)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    int shelf_x = 0, shelf_y = 0, shelf_height = 0, atlas_width = 0;
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        const Image* image = &images[order[i]];
+
+        if (shelf_x > 0 && shelf_x + image->width > ATLAS_MAX_WIDTH)
+        {
+            shelf_y += shelf_height + ATLAS_PADDING;
+            shelf_x = 0;
+            shelf_height = 0;
+        }
+
+        sprites[order[i]] = (Rectangle){
+            (float)shelf_x, (float)shelf_y, (float)image->width, (float)image->height
+        };
+
+        shelf_x += image->width + ATLAS_PADDING;
+        if (image->height > shelf_height) shelf_height = image->height;
+        if (shelf_x > atlas_width) atlas_width = shelf_x;
+    }
+
+    const int atlas_height = shelf_y + shelf_height;
+    Image packed = GenImageColor(atlas_width, atlas_height, BLANK);
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        const Rectangle source = {0, 0, (float)images[i].width, (float)images[i].height};
+        ImageDraw(&packed, images[i], source, sprites[i], WHITE);
+    }
+
+    TraceLog(LOG_INFO, "Packed %d sprites into a %dx%d atlas", SPRITE_COUNT, atlas_width, atlas_height);
+    return packed;
+}
+
+/**
+ * @brief Uploads a packed atlas image to the GPU
+ *
+ * @param packed Image returned by pack_texture_atlas(), unloaded by this function
+ * @param sprites Sub-rectangles returned by pack_texture_atlas()
+ * @return Atlas texture and the sub-rectangle of every sprite
+ *
+ * @details Must run on the thread owning the window
+ */
+TextureAtlas upload_texture_atlas(const Image packed, const Rectangle sprites[SPRITE_COUNT])
+{
+    TextureAtlas atlas = {0};
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        atlas.sprites[i] = sprites[i];
+    }
+
+    atlas.texture = LoadTextureFromImage(packed);
+    UnloadImage(packed);
+    if (atlas.texture.id != 0) track_alloc(MEM_ASSETS, MEM_GPU, texture_bytes(atlas.texture));
+    return atlas;
+}
+
+/**
+ * @brief Packs images into one texture
+ *
+ * @param images One image per SpriteId, not modified
+ * @return Atlas texture and the sub-rectangle of every sprite
+ *
+ * @details Requires an active window for the texture upload
+ */
+TextureAtlas build_texture_atlas(const Image images[SPRITE_COUNT])
+{
+    Rectangle sprites[SPRITE_COUNT];
+    const Image packed = pack_texture_atlas(images, sprites);
+    return upload_texture_atlas(packed, sprites);
+}
+
+/**
+ * @brief Releases the atlas texture
+ *
+ * @param atlas Pointer to the atlas to unload
+ */
+void unload_texture_atlas(TextureAtlas* atlas)
+{
+    if (atlas->texture.id != 0) track_free(MEM_ASSETS, MEM_GPU, texture_bytes(atlas->texture));
+    UnloadTexture(atlas->texture);
+    *atlas = (TextureAtlas){0};
+}
+
+/**
+ * @brief Returns the unscaled size of a sprite
+ *
+ * @param atlas Pointer to the atlas
+ * @param sprite Sprite to measure
+ * @return Width and height in pixels
+ */
+Vector2 sprite_size(const TextureAtlas* atlas, const SpriteId sprite)
+{
+    return (Vector2){atlas->sprites[sprite].width, atlas->sprites[sprite].height};
+}
+
+/**
+ * @brief Returns the size a sprite has to be drawn at in the current window
+ *
+ * @param atlas Pointer to the atlas
+ * @param sprite Sprite to measure
+ * @param screen_width Window width
+ * @param screen_height Window height
+ * @return Display size, equal to sprite_size() unless a resize is still pending
+ */
+Vector2 sprite_draw_size(const TextureAtlas* atlas, const SpriteId sprite, const int screen_width,
+                         const int screen_height)
+{
+    const Vector2 size = sprite_size(atlas, sprite);
+    if (sprite != SPRITE_MAIN_MENU) return size;
+
+    const Vector2 wanted = sprite_display_size(sprite, (int)size.x, (int)size.y, screen_width, screen_height);
+    return (int)wanted.x < 1 || (int)wanted.y < 1 ? size : wanted;
+}
+
+/**
+ * @brief Draws a sprite from the atlas
+ *
+ * @param atlas Pointer to the atlas
+ * @param sprite Sprite to draw
+ * @param position Top left corner on screen
+ * @param scale Scale applied to the sprite's size
+ * @param tint Color tint, WHITE for none
+ */
+void draw_sprite(const TextureAtlas* atlas, const SpriteId sprite, const Vector2 position, const float scale,
+                 const Color tint)
+{
+    const Rectangle source = atlas->sprites[sprite];
+    const Rectangle dest = {position.x, position.y, source.width * scale, source.height * scale};
+
+    DrawTexturePro(atlas->texture, source, dest, (Vector2){0, 0}, 0.0f, tint);
+}
+
+/**
+ * @brief Draws a sprite from the atlas stretched to a rectangle
+ *
+ * @param atlas Pointer to the atlas
+ * @param sprite Sprite to draw
+ * @param dest Rectangle on screen
+ * @param tint Color tint, WHITE for none
+ */
+void draw_sprite_sized(const TextureAtlas* atlas, const SpriteId sprite, const Rectangle dest, const Color tint)
+{
+    DrawTexturePro(atlas->texture, atlas->sprites[sprite], dest, (Vector2){0, 0}, 0.0f, tint);
+}
@@ -0,0 +1,300 @@
+/**
+ * @file audio.c
+ * @brief Audio thread pumping the music stream and playing sound effects
+ *
+ * The main thread only posts events to a single-producer, single-consumer ring, it
+ * never calls into raylib's audio itself. The audio thread wakes every
+ * AUDIO_PUMP_INTERVAL_MS on an absolute schedule, refills the music stream and plays
+ * whatever was posted, so a slow frame or a long search cannot starve the stream.
+ * Between pumps it waits on a condition variable against CLOCK_MONOTONIC, so
+ * cleanup_audio() can wake it at once instead of waiting out the interval.
+ *
+ * Sound effects are decoded to PCM once, on the audio thread, and stay resident in
+ * a small cache until cleanup. The decode of each effect is spread over the first
+ * pumps so the music starts without waiting for them.
+ */
+#include <audio.h>
+#include <loader.h>
+#include <mem_stats.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <time.h>
+
+typedef enum {
+    AUDIO_EVENT_PLAY_SFX,
+    AUDIO_EVENT_PLAY_MUSIC,
+    AUDIO_EVENT_STOP_MUSIC
+} AudioEventType;
+
+typedef struct {
+    AudioEventType type;
+    SfxId sfx;
+} AudioEvent;
+
+static const char* const SFX_PATHS[SFX_COUNT] = {
+    [SFX_CLICK] = "assets/btn_click.mp3",
+    [SFX_SYMBOL] = "assets/click_symbol.mp3",
+    [SFX_WIN] = "assets/game_win.mp3",
+    [SFX_DRAW] = "assets/game_draw.mp3",
+};
+
+static struct {
+    // Ring of posted events, tail is written by the main thread and head by the audio thread
+    AudioEvent events[AUDIO_QUEUE_CAPACITY];
+    atomic_uint head;
+    atomic_uint tail;
+    unsigned int dropped;   // Main thread only
+
+    // Owned by the audio thread while it runs
+    Music* music;
+    bool music_playing;
+    Sound sfx[SFX_COUNT];
+    bool sfx_decoded[SFX_COUNT];
+
+    pthread_t thread;
+    pthread_mutex_t wake_lock;
+    pthread_cond_t wake;     // Signalled when stopping is set
+    atomic_bool stopping;
+    bool running;
+} audio = {0};
+
+/**
+ * @brief Appends an event for the audio thread, main thread only
+ */
+static void post_audio_event(const AudioEvent event)
+{
+    if (!audio.running) return;
+
+    const unsigned int tail = atomic_load_explicit(&audio.tail, memory_order_relaxed);
+    const unsigned int head = atomic_load_explicit(&audio.head, memory_order_acquire);
+    if (tail - head == AUDIO_QUEUE_CAPACITY)
+    {
+        audio.dropped++;
+        return;
+    }
+
+    audio.events[tail % AUDIO_QUEUE_CAPACITY] = event;
+    atomic_store_explicit(&audio.tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Size of a decoded sound effect, raylib converts it to the device format
+ */
+static size_t sfx_bytes(const Sound sound)
+{
+    return (size_t)sound.frameCount * sound.stream.channels * sound.stream.sampleSize / 8;
+}
+
+/**
+ * @brief Decodes a sound effect into the cache, audio thread only
+ */
+static void decode_sfx(const SfxId sfx)
+{
+    audio.sfx_decoded[sfx] = true; // Not retried after a load error
+
+    Wave wave = load_wave_asset(SFX_PATHS[sfx]);
+    if (wave.data == NULL)
+    {
+        TraceLog(LOG_WARNING, "Failed to decode sound effect %s", SFX_PATHS[sfx]);
+        return;
+    }
+    audio.sfx[sfx] = LoadSoundFromWave(wave);
+    if (audio.sfx[sfx].frameCount > 0) track_alloc(MEM_AUDIO, MEM_HEAP, sfx_bytes(audio.sfx[sfx]));
+    UnloadWave(wave);
+}
+
+static void run_audio_event(const AudioEvent* event)
+{
+    switch (event->type)
+    {
+    case AUDIO_EVENT_PLAY_SFX:
+        if (!audio.sfx_decoded[event->sfx]) decode_sfx(event->sfx);
+        if (audio.sfx[event->sfx].frameCount > 0) PlaySound(audio.sfx[event->sfx]);
+        break;
+    case AUDIO_EVENT_PLAY_MUSIC:
+        PlayMusicStream(*audio.music);
+        audio.music_playing = true;
+        break;
+    case AUDIO_EVENT_STOP_MUSIC:
+        StopMusicStream(*audio.music);
+        audio.music_playing = false;
+        break;
+    }
+}
+
+/**
+ * @brief Advances an absolute deadline by one pump interval
+ */
+static void advance_deadline(struct timespec* deadline)
+{
+    deadline->tv_nsec += AUDIO_PUMP_INTERVAL_MS * 1000000L;
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * @brief Sleeps until an absolute CLOCK_MONOTONIC deadline or until the thread is stopped
+ */
+static void wait_for_deadline(const struct timespec* deadline)
+{
+    pthread_mutex_lock(&audio.wake_lock);
+    int result = 0;
+    while (!atomic_load(&audio.stopping) && result != ETIMEDOUT)
+    {
+#ifdef __APPLE__
+        // Condition variables cannot use the monotonic clock here, wait for the time left instead
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        struct timespec left = {deadline->tv_sec - now.tv_sec, deadline->tv_nsec - now.tv_nsec};
+        if (left.tv_nsec < 0)
+        {
+            left.tv_sec--;
+            left.tv_nsec += 1000000000L;
+        }
+        if (left.tv_sec < 0) break;
+        result = pthread_cond_timedwait_relative_np(&audio.wake, &audio.wake_lock, &left);
+#else
+        result = pthread_cond_timedwait(&audio.wake, &audio.wake_lock, deadline);
+#endif
+    }
+    pthread_mutex_unlock(&audio.wake_lock);
+}
+
+static void* audio_main(void* arg)
+{
+    (void)arg;
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    int next_decode = 0;
+
+    while (!atomic_load(&audio.stopping))
+    {
+        const unsigned int tail = atomic_load_explicit(&audio.tail, memory_order_acquire);
+        unsigned int head = atomic_load_explicit(&audio.head, memory_order_relaxed);
+        while (head != tail)
+        {
+            run_audio_event(&audio.events[head % AUDIO_QUEUE_CAPACITY]);
+            head++;
+        }
+        atomic_store_explicit(&audio.head, head, memory_order_release);
+
+        if (audio.music_playing) UpdateMusicStream(*audio.music);
+
+        // Warm the cache one effect per pump, after the stream has been refilled
+        while (next_decode < SFX_COUNT && audio.sfx_decoded[next_decode]) next_decode++;
+        if (next_decode < SFX_COUNT) decode_sfx(next_decode);
+
+        // Absolute deadlines keep the schedule from drifting by the time spent above
+        advance_deadline(&deadline);
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (now.tv_sec > deadline.tv_sec || (now.tv_sec == deadline.tv_sec && now.tv_nsec > deadline.tv_nsec))
+        {
+            deadline = now; // Overran, e.g. while decoding, restart the schedule from now
+            continue;
+        }
+        wait_for_deadline(&deadline);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Starts the audio thread
+ *
+ * @param music Background music stream, must stay valid until cleanup_audio()
+ * @return true if the thread started, sound is silent otherwise
+ *
+ * @details The audio device must be initialised. From here on only the audio
+ * thread touches the music stream and sound effects.
+ */
+bool init_audio(Music* music)
+{
+    audio.music = music;
+    atomic_store(&audio.head, 0);
+    atomic_store(&audio.tail, 0);
+    atomic_store(&audio.stopping, false);
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+#ifndef __APPLE__
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+#endif
+    pthread_cond_init(&audio.wake, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&audio.wake_lock, NULL);
+
+    if (pthread_create(&audio.thread, NULL, audio_main, NULL) != 0)
+    {
+        TraceLog(LOG_ERROR, "Failed to start audio thread");
+        pthread_cond_destroy(&audio.wake);
+        pthread_mutex_destroy(&audio.wake_lock);
+        return false;
+    }
+    audio.running = true;
+    return true;
+}
+
+/**
+ * @brief Stops the audio thread and unloads the sound effect cache
+ *
+ * @details Call before unloading the music stream and closing the audio device
+ */
+void cleanup_audio(void)
+{
+    if (!audio.running) return;
+
+    // Set under the lock so the thread cannot miss the signal between its check and its wait
+    pthread_mutex_lock(&audio.wake_lock);
+    atomic_store(&audio.stopping, true);
+    pthread_cond_signal(&audio.wake);
+    pthread_mutex_unlock(&audio.wake_lock);
+    pthread_join(audio.thread, NULL);
+    pthread_cond_destroy(&audio.wake);
+    pthread_mutex_destroy(&audio.wake_lock);
+    audio.running = false;
+
+    if (audio.music_playing) StopMusicStream(*audio.music);
+    for (int i = 0; i < SFX_COUNT; i++)
+    {
+        if (audio.sfx[i].frameCount > 0)
+        {
+            track_free(MEM_AUDIO, MEM_HEAP, sfx_bytes(audio.sfx[i]));
+            UnloadSound(audio.sfx[i]);
+        }
+        audio.sfx[i] = (Sound){0};
+        audio.sfx_decoded[i] = false;
+    }
+    audio.music_playing = false;
+    audio.music = NULL;
+
+    if (audio.dropped > 0) TraceLog(LOG_WARNING, "Audio queue full, %u events dropped", audio.dropped);
+}
+
+/**
+ * @brief Plays a sound effect on the next pump
+ */
+void play_sfx(const SfxId sfx)
+{
+    post_audio_event((AudioEvent){AUDIO_EVENT_PLAY_SFX, sfx});
+}
+
+/**
+ * @brief Starts the background music from the beginning
+ */
+void play_music(void)
+{
+    post_audio_event((AudioEvent){AUDIO_EVENT_PLAY_MUSIC});
+}
+
+/**
+ * @brief Stops the background music
+ */
+void stop_music(void)
+{
+    post_audio_event((AudioEvent){AUDIO_EVENT_STOP_MUSIC});
+}
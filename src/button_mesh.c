@@ -0,0 +1,127 @@
+/**
+ * @file button_mesh.c
+ * @brief Pre-tessellated button geometry
+ *
+ * Button fills and outlines are turned into triangle lists when the layout changes.
+ * Every frame a button group is submitted as one run of triangles in a single rlgl
+ * batch, the hover state only changes the color given to each button's vertices.
+ */
+#include <button_mesh.h>
+#include <math.h>
+#include <rlgl.h>
+
+/**
+ * @brief Builds the fill and outline triangles of a button
+ *
+ * @param geometry Geometry to fill in
+ * @param rect Button rectangle
+ * @param rounded true for rounded corners, false for square ones
+ */
+void tessellate_button(ButtonGeometry* geometry, const Rectangle rect, const bool rounded)
+{
+    Vector2 inner[BUTTON_PERIMETER_POINTS];
+    Vector2 outer[BUTTON_PERIMETER_POINTS];
+    int points = 0;
+
+    const float radius = rounded ? BUTTON_ROUNDNESS * fminf(rect.width, rect.height) / 2 : 0.0f;
+    const float thick = BUTTON_OUTLINE_THICKNESS;
+
+    // Corner centers clockwise from the top left, with the angle each corner arc starts at
+    const Vector2 centers[4] = {
+        {rect.x + radius, rect.y + radius},
+        {rect.x + rect.width - radius, rect.y + radius},
+        {rect.x + rect.width - radius, rect.y + rect.height - radius},
+        {rect.x + radius, rect.y + rect.height - radius}
+    };
+    static const float START_ANGLES[4] = {180.0f, 270.0f, 0.0f, 90.0f};
+    static const Vector2 SQUARE_DIRS[4] = {{-1, -1}, {1, -1}, {1, 1}, {-1, 1}};
+
+    for (int corner = 0; corner < 4; corner++)
+    {
+        if (!rounded)
+        {
+            // A square corner is one point, the outline is pushed out diagonally to stay square
+            inner[points] = centers[corner];
+            outer[points] = (Vector2){
+                centers[corner].x + SQUARE_DIRS[corner].x * thick,
+                centers[corner].y + SQUARE_DIRS[corner].y * thick
+            };
+            points++;
+            continue;
+        }
+
+        for (int segment = 0; segment <= BUTTON_CORNER_SEGMENTS; segment++)
+        {
+            const float angle = (START_ANGLES[corner] + 90.0f * (float)segment / BUTTON_CORNER_SEGMENTS) * DEG2RAD;
+            const float dx = cosf(angle), dy = sinf(angle);
+
+            inner[points] = (Vector2){centers[corner].x + dx * radius, centers[corner].y + dy * radius};
+            outer[points] = (Vector2){
+                centers[corner].x + dx * (radius + thick), centers[corner].y + dy * (radius + thick)
+            };
+            points++;
+        }
+    }
+
+    // The rounded rectangle is convex, so the fill is a fan around its center
+    const Vector2 center = {rect.x + rect.width / 2, rect.y + rect.height / 2};
+    geometry->fill_count = 0;
+    geometry->outline_count = 0;
+
+    for (int i = 0; i < points; i++)
+    {
+        const int next = (i + 1) % points;
+
+        // Counter-clockwise winding, as rlgl expects
+        geometry->fill[geometry->fill_count++] = center;
+        geometry->fill[geometry->fill_count++] = inner[next];
+        geometry->fill[geometry->fill_count++] = inner[i];
+
+        geometry->outline[geometry->outline_count++] = inner[i];
+        geometry->outline[geometry->outline_count++] = outer[next];
+        geometry->outline[geometry->outline_count++] = outer[i];
+        geometry->outline[geometry->outline_count++] = inner[i];
+        geometry->outline[geometry->outline_count++] = inner[next];
+        geometry->outline[geometry->outline_count++] = outer[next];
+    }
+}
+
+/**
+ * @brief Submits the geometry of a button group as one batch of triangles
+ *
+ * @param geometries Geometry of each button
+ * @param fill_colors Fill color of each button, e.g. its hover color
+ * @param count Number of buttons
+ * @param outline_color Color of every outline
+ */
+void draw_button_geometry(const ButtonGeometry* const geometries[], const Color fill_colors[], const size_t count,
+                          const Color outline_color)
+{
+    int vertex_count = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        vertex_count += geometries[i]->fill_count + geometries[i]->outline_count;
+    }
+
+    // Flush beforehand if the group would not fit, so it is never split mid-batch
+    rlCheckRenderBatchLimit(vertex_count);
+
+    rlBegin(RL_TRIANGLES);
+    for (size_t i = 0; i < count; i++)
+    {
+        const ButtonGeometry* geometry = geometries[i];
+
+        rlColor4ub(fill_colors[i].r, fill_colors[i].g, fill_colors[i].b, fill_colors[i].a);
+        for (int v = 0; v < geometry->fill_count; v++)
+        {
+            rlVertex2f(geometry->fill[v].x, geometry->fill[v].y);
+        }
+
+        rlColor4ub(outline_color.r, outline_color.g, outline_color.b, outline_color.a);
+        for (int v = 0; v < geometry->outline_count; v++)
+        {
+            rlVertex2f(geometry->outline[v].x, geometry->outline[v].y);
+        }
+    }
+    rlEnd();
+}
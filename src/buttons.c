@@ -1,3 +1,5 @@
+#include <ai_worker.h>
+#include <audio.h>
 #include <buttons.h>
 #include <game.h>
 // Button click handlers
@@ -9,7 +11,7 @@
  */
 static void start_easy_mode_naive(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->selected_game_mode = ONE_PLAYER_EASY_NAIVE;
     context->computer_enabled = true;
     initialize_game(res, context);
@@ -23,7 +25,7 @@ static void start_easy_mode_naive(const GameResources *res, GameContext *context
  */
 static void start_easy_mode_NN(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->selected_game_mode = ONE_PLAYER_EASY_NN;
     context->computer_enabled = true;
     initialize_game(res, context);
@@ -37,7 +39,7 @@ static void start_easy_mode_NN(const GameResources *res, GameContext *context)
  */
 static void start_medium_mode(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->selected_game_mode = ONE_PLAYER_MEDIUM;
     context->computer_enabled = true;
     initialize_game(res, context);
@@ -51,7 +53,7 @@ static void start_medium_mode(const GameResources *res, GameContext *context)
  */
 static void start_hard_mode(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->selected_game_mode = ONE_PLAYER_HARD;
     context->computer_enabled = true;
     initialize_game(res, context);
@@ -66,7 +68,7 @@ static void start_hard_mode(const GameResources *res, GameContext *context)
  */
 static void continue_playing(const GameResources *res, GameContext *context)
 {
-    context->transition.start_time = 0;
+    context->transition.elapsed = 0;
     context->transition.active = false;
     context->player_1 = context->player_1 == PLAYER_X ? PLAYER_O : PLAYER_X;
     initialize_game(res, context);
@@ -80,9 +82,10 @@ static void continue_playing(const GameResources *res, GameContext *context)
  */
 static void return_to_menu(const GameResources *res, GameContext *context)
 {
-    context->transition.start_time = 0;
+    ai_worker_cancel(context->ai_worker);
+    context->transition.elapsed = 0;
     context->transition.active = false;
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->p1_score = 0;
     context->p2_score = 0;
     context->draw_score = 0;
@@ -96,7 +99,7 @@ static void return_to_menu(const GameResources *res, GameContext *context)
  */
 static void exit_game(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->exit_flag = true;
 }
 /**
@@ -106,7 +109,7 @@ static void exit_game(const GameResources *res, GameContext *context)
  */
 static void start_1player(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->state = MENU_DIFF_CHOICE;
 }
 /**
@@ -116,7 +119,7 @@ static void start_1player(const GameResources *res, GameContext *context)
  */
 static void start_2player(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->selected_game_mode = TWO_PLAYER;
     context->computer_enabled = false;
     initialize_game(res, context);
@@ -129,7 +132,7 @@ static void start_2player(const GameResources *res, GameContext *context)
  */
 static void show_instructions(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->state = MENU_INSTRUCTIONS;
 }
 /**
@@ -139,7 +142,7 @@ static void show_instructions(const GameResources *res, GameContext *context)
  */
 static void show_exit_confirmation(const GameResources *res, GameContext *context)
 {
-    PlaySound(res->fx_click);
+    play_sfx(SFX_CLICK);
     context->state = GAME_STATE_EXIT;
 }
 
@@ -1,59 +1,110 @@
 #include "computer.h"
+#include <asset_pak.h>
+#include <mem_stats.h>
+#include <model_store.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <tgmath.h>
+#include <time.h>
 #include <utils.h>
 
+// Flag polled by minimax on this thread, set when a background search is cancelled
+static _Thread_local atomic_bool* search_abort = NULL;
+
+// Statistics of the search running on this thread, NULL when not collecting
+static _Thread_local SearchStats* active_stats = NULL;
+
+#define STATS_ADD(field, amount) do { if (active_stats) active_stats->field += (amount); } while (0)
+
 /**
- * @brief Load the saved neural network model from nn_weights.dat.
- * 
- * @return Pointer to the loaded NeuralNetwork struct, or NULL on failure.
+ * @brief Registers the cancellation flag polled by searches on the calling thread
+ *
+ * @param flag Flag that aborts the search when set, NULL to disable
  */
-NeuralNetwork* load_model()
+void set_search_abort_flag(atomic_bool* flag)
+{
+    search_abort = flag;
+}
+
+/**
+ * @brief Read the saved neural network model from nn_weights.dat into caller-owned memory.
+ *
+ * @param nn NeuralNetwork to fill, e.g. allocated from the session arena
+ * @return true on success
+ */
+bool read_model(NeuralNetwork* nn)
 {
     const static char weights_path[] = "assets/nn_weights.dat";
-    NeuralNetwork* nn = malloc(sizeof(NeuralNetwork)); // this allocates memory for the neural network
-    FILE* file = fopen(weights_path, "rb"); // open the nn_weights file that is binary read mode
-    if (file == NULL)
+    AssetReader reader;
+    if (!open_asset_reader(&reader, weights_path)) // open nn_weights from the asset pak or the file
     {
         TraceLog(LOG_ERROR, "Failed to load Neural net\n");
-        return NULL; // if file cannot open, return NULL
+        return false; // if file cannot open, return false
     }
 
     // read weights and biases from the file and load into the neural network
-    fread(nn->hidden_weights, sizeof(double), HIDDEN_NODES * INPUT_NODES, file);
-    fread(nn->bias_hidden, sizeof(double), HIDDEN_NODES, file);
-    fread(nn->output_weights, sizeof(double), OUTPUT_NODES * HIDDEN_NODES, file);
-    fread(nn->bias_output, sizeof(double), OUTPUT_NODES, file);
+    read_asset(&reader, nn->hidden_weights, sizeof(double) * HIDDEN_NODES * INPUT_NODES);
+    read_asset(&reader, nn->bias_hidden, sizeof(double) * HIDDEN_NODES);
+    read_asset(&reader, nn->output_weights, sizeof(double) * OUTPUT_NODES * HIDDEN_NODES);
+    read_asset(&reader, nn->bias_output, sizeof(double) * OUTPUT_NODES);
 
-    fclose(file); // close the file after loading
+    close_asset_reader(&reader); // close the file after loading
     TraceLog(LOG_INFO, "Model loaded successfully from %s", weights_path);
+    return true;
+}
+
+/**
+ * @brief Load the saved neural network model from nn_weights.dat.
+ * 
+ * @return Pointer to the loaded NeuralNetwork struct, or NULL on failure.
+ */
+NeuralNetwork* load_model()
+{
+    NeuralNetwork* nn = malloc(sizeof(NeuralNetwork)); // this allocates memory for the neural network
+    if (nn && !read_model(nn))
+    {
+        free(nn);
+        return NULL;
+    }
+    if (nn) track_alloc(MEM_AI, MEM_HEAP, sizeof(NeuralNetwork));
     return nn; // return pointer to the loaded neural network
 }
 
-//load the naive bayes data
-BayesModel* load_naive_bayes()
+//read the naive bayes data into caller-owned memory
+bool read_naive_bayes(BayesModel* model)
 {
     const static char model_path[] = "assets/bayes_model.dat"; //path to where the file is 
-    BayesModel* model = malloc(sizeof(BayesModel)); //allocate memory for the naive bayes structure
-    FILE* file = fopen(model_path, "rb"); //open the file in binary mode
+    AssetReader reader;
 
-    if (!file) {
+    if (!open_asset_reader(&reader, model_path)) { //open the model from the asset pak or the file
         TraceLog(LOG_ERROR, "Fail to load Bayes model"); //log an error message if the file could not be opened
-        return NULL; //return null to indicate failure
+        return false; //return false to indicate failure
     }
 
-    fread(model->prob_x, sizeof(double), 9, file); //read the probability for 'X' 
-    fread(model->prob_o, sizeof(double), 9, file); //read the probability for 'O' 
-    fread(model->prob_b, sizeof(double), 9, file); //read the probability for 'B' 
-    fread(&model->prob_win, sizeof(double), 1, file); //reading the probability of winning 
-    fread(&model->prob_lose, sizeof(double), 1, file); //reading the probability of losing 
-    fread(&model->total_win, sizeof(int), 1, file); //reading the total count of wins 
-    fread(&model->total_lose, sizeof(int), 1, file); //reading the total count of losses
+    read_asset(&reader, model->prob_x, sizeof(double) * 9); //read the probability for 'X' 
+    read_asset(&reader, model->prob_o, sizeof(double) * 9); //read the probability for 'O' 
+    read_asset(&reader, model->prob_b, sizeof(double) * 9); //read the probability for 'B' 
+    read_asset(&reader, &model->prob_win, sizeof(double)); //reading the probability of winning 
+    read_asset(&reader, &model->prob_lose, sizeof(double)); //reading the probability of losing 
+    read_asset(&reader, &model->total_win, sizeof(int)); //reading the total count of wins 
+    read_asset(&reader, &model->total_lose, sizeof(int)); //reading the total count of losses
 
-    fclose(file); //close file
+    close_asset_reader(&reader); //close file
     TraceLog(LOG_INFO, "Model loaded from %s", model_path); //logging a message to indicate that it was successful
 
+    return true;
+}
+
+//load the naive bayes data
+BayesModel* load_naive_bayes()
+{
+    BayesModel* model = malloc(sizeof(BayesModel)); //allocate memory for the naive bayes structure
+    if (model && !read_naive_bayes(model))
+    {
+        free(model);
+        return NULL; //return null to indicate failure
+    }
+    if (model) track_alloc(MEM_AI, MEM_HEAP, sizeof(BayesModel));
     return model; //return loaded model 
 }
 
@@ -62,31 +113,35 @@ BayesModel* load_naive_bayes()
  * 
  * @param nn Pointer to the neural network.
  * @param input Array of input features.
+ * @param hidden_layer Caller-owned buffer receiving the hidden layer activations.
+ * @param output_layer Caller-owned buffer receiving the output layer activations.
+ *
+ * @note The model itself is never written, so one network can be shared between threads.
  */
-void forward_pass(NeuralNetwork* nn, const double input[])
+void forward_pass(const NeuralNetwork* nn, const double input[], double hidden_layer[], double output_layer[])
 {
     // compute the activations for the hidden layer
     for (int i = 0; i < HIDDEN_NODES; i++)
     {
-        nn->hidden_layer[i] = nn->bias_hidden[i]; // this initializes the network with bias
+        hidden_layer[i] = nn->bias_hidden[i]; // this initializes the network with bias
         for (int j = 0; j < INPUT_NODES; j++)
         {
-            nn->hidden_layer[i] += nn->hidden_weights[i][j] * input[j]; // calculate weighted sum
+            hidden_layer[i] += nn->hidden_weights[i][j] * input[j]; // calculate weighted sum
         }
         // ReLU activation function
-        nn->hidden_layer[i] = nn->hidden_layer[i] > 0 ? nn->hidden_layer[i] : 0.0;
+        hidden_layer[i] = hidden_layer[i] > 0 ? hidden_layer[i] : 0.0;
     }
 
     // compute the activations for the output layer
     for (int i = 0; i < OUTPUT_NODES; i++)
     {
-        nn->output_layer[i] = nn->bias_output[i]; // this initializes the network with bias
+        output_layer[i] = nn->bias_output[i]; // this initializes the network with bias
         for (int j = 0; j < HIDDEN_NODES; j++)
         {
-            nn->output_layer[i] += nn->output_weights[i][j] * nn->hidden_layer[j]; // calculate weighted sum
+            output_layer[i] += nn->output_weights[i][j] * hidden_layer[j]; // calculate weighted sum
         }
         // sigmoid activation function
-        nn->output_layer[i] = 1.0 / (1.0 + exp(-nn->output_layer[i]));
+        output_layer[i] = 1.0 / (1.0 + exp(-output_layer[i]));
     }
 }
 
@@ -138,7 +193,7 @@ double predict_naive_bayes(const BayesModel* model, int const computer_player) {
  * @param computer_player The computer's player type (PLAYER_X or PLAYER_O).
  * @return EvalResult Struct containing the best score and the index of the best move.
  */
-EvalResult nn_move(NeuralNetwork* nn, const player_t computer_player)
+EvalResult nn_move(const NeuralNetwork* nn, const player_t computer_player)
 {
     int best_move = -1;                     // initialize the index of the best move
     double best_score = -INFINITY;          // initialize the best score to negative infinity
@@ -182,8 +237,12 @@ EvalResult nn_move(NeuralNetwork* nn, const player_t computer_player)
         }
 
         // Perform a forward pass through the neural network to evaluate the move
-        forward_pass(nn, input);
-        const double score = nn->output_layer[0]; // Neural network output score for the move
+        STATS_ADD(nodes, 1);
+        STATS_ADD(leaf_evals, 1);
+        double hidden_layer[HIDDEN_NODES];
+        double output_layer[OUTPUT_NODES];
+        forward_pass(nn, input, hidden_layer, output_layer);
+        const double score = output_layer[0]; // Neural network output score for the move
 
         // Undo the simulated move to restore the original board state
         if (computer_player == PLAYER_X)
@@ -234,6 +293,8 @@ EvalResult nb_move(const BayesModel* model, const player_t computer_player)
 
 
         //use naive bayes model to evaluate probabilites of winning for this move
+        STATS_ADD(nodes, 1);
+        STATS_ADD(leaf_evals, 1);
         const double score = predict_naive_bayes(model, computer_player);
         //update the best score and move
         if (score > best_score)
@@ -274,14 +335,36 @@ EvalResult nb_move(const BayesModel* model, const player_t computer_player)
 // Computer simulates opponent's move to make the optimal move
 EvalResult minimax(const player_t current_player, int alpha, int beta, const int depth, const GameContext* context)
 {
+    // Bail out of a cancelled background search, the caller discards the result
+    if (search_abort && atomic_load_explicit(search_abort, memory_order_relaxed)) return (EvalResult){0, -1};
+
     // Dynamically determine the human and computer players
     const player_t human = get_human_player(context);
     const player_t computer = get_computer_player(context);
-    
+
+    if (active_stats)
+    {
+        const int ply = active_stats->search_depth - depth;
+        active_stats->nodes++;
+        if (ply > active_stats->max_ply) active_stats->max_ply = ply;
+    }
+
     // Check win conditions
-    if (check_win(human) != -1) return (EvalResult){-1, -1};
-    if (check_win(computer) != -1) return (EvalResult){1, -1};
-    if (check_draw() || depth == 0) return (EvalResult){0, -1};
+    if (check_win(human) != -1)
+    {
+        STATS_ADD(leaf_evals, 1);
+        return (EvalResult){-1, -1};
+    }
+    if (check_win(computer) != -1)
+    {
+        STATS_ADD(leaf_evals, 1);
+        return (EvalResult){1, -1};
+    }
+    if (check_draw() || depth == 0)
+    {
+        STATS_ADD(leaf_evals, 1);
+        return (EvalResult){0, -1};
+    }
 
     // Ternary operator: (condition) ? (value_if_true) : (value_if_false)
     double bestScore = current_player == computer ? -2 : 2; // Initialise bestScore based on player, human is -2, computer is 2; -2 and 2 is selected -> they act as the -inf and inf, goal is to increase -2 and decrease 2
@@ -290,6 +373,7 @@ EvalResult minimax(const player_t current_player, int alpha, int beta, const int
     // Initialized condition to check if the chosen move is legal, meaning the cell is not occupied
     const uint16_t occupied_board = x_board | o_board;
     uint16_t legal_moves = ~occupied_board & 0b111111111;
+    int move_index = 0; // Order in which moves are tried, for cutoff statistics
 
     while (legal_moves)
     {
@@ -341,11 +425,17 @@ EvalResult minimax(const player_t current_player, int alpha, int beta, const int
         // Because, for the maximizing player, a move with a score less than the alpha would be irrelevant because a better option already exists
         // Optimizes minimax as the number of possible moves being evaluated is reduced
         if (alpha >= beta) {
+            if (active_stats)
+            {
+                active_stats->cutoffs++;
+                active_stats->cutoffs_by_move[move_index]++;
+            }
             break;
         }
 
         // Remove move from legal_moves
         legal_moves &= ~(1 << move);
+        move_index++;
     }
 
     return (EvalResult){bestScore, bestMove};
@@ -353,43 +443,155 @@ EvalResult minimax(const player_t current_player, int alpha, int beta, const int
 
 
 /**
- * @brief Execute computer's move using various algorithms selected by current game difficulty
+ * @brief Loads every AI model used by the single player difficulties
  *
- * @param context Current game context
- * @param models struct containing ML model parameters
+ * @return Pointer to a heap allocated AiModels, release with unload_ai_models()
  */
-void computer_move(const GameContext* context, const AiModels* models) {
+AiModels* load_ai_models(void)
+{
+    AiModels* models = malloc(sizeof(AiModels));
+    if (!models)
+    {
+        TraceLog(LOG_ERROR, "Failed to allocate AI models");
+        return NULL;
+    }
+    open_asset_pak(); // Headless modes read the models from the pak too
+
+    // Shared with the other instances on this host, private copies if that fails
+    models->neural_network = shared_neural_network();
+    if (!models->neural_network) models->neural_network = load_model();
+    models->bayes_model = shared_bayes_model();
+    if (!models->bayes_model) models->bayes_model = load_naive_bayes();
+    return models;
+}
+
+/**
+ * @brief Releases models returned by load_ai_models()
+ *
+ * @param models Pointer to the AiModels to free, may be NULL
+ */
+void unload_ai_models(AiModels* models)
+{
+    if (!models) return;
+    if (models->neural_network && models->neural_network != shared_neural_network())
+    {
+        track_free(MEM_AI, MEM_HEAP, sizeof(NeuralNetwork));
+        free((void*)models->neural_network);
+    }
+    if (models->bayes_model && models->bayes_model != shared_bayes_model())
+    {
+        track_free(MEM_AI, MEM_HEAP, sizeof(BayesModel));
+        free((void*)models->bayes_model);
+    }
+    free(models);
+    detach_model_store();
+}
+
+/**
+ * @brief Runs the engine selected by the game difficulty
+ */
+static EvalResult run_engine(const GameContext* context, const AiModels* models, SearchStats* stats)
+{
     const player_t computer_player = get_computer_player(context);
-    EvalResult result;
 
     switch (context->selected_game_mode)
     {
-
     case ONE_PLAYER_EASY_NAIVE:
-        result = nb_move(models->bayes_model, computer_player);
+        if (stats) stats->search_depth = 1;
+        if (models && models->bayes_model) return nb_move(models->bayes_model, computer_player);
         break;
 
     case ONE_PLAYER_EASY_NN:
-        result = nn_move(models->neural_network, computer_player);
+        if (stats) stats->search_depth = 1;
+        if (models && models->neural_network) return nn_move(models->neural_network, computer_player);
         break;
 
     case ONE_PLAYER_MEDIUM:
-        result = minimax(computer_player, -2, 2, 3, context);
-        break;
+        if (stats) stats->search_depth = 3;
+        return minimax(computer_player, -2, 2, 3, context);
 
     case ONE_PLAYER_HARD:
-        result = minimax(computer_player, -2, 2, 9, context);
-        break;
+        if (stats) stats->search_depth = 9;
+        return minimax(computer_player, -2, 2, 9, context);
 
     default:
-        return;
+        break;
+    }
+
+    return (EvalResult){0, -1};
+}
+
+static double now_seconds(void)
+{
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Picks the computer's move using the algorithm selected by current game difficulty
+ *
+ * @param context Current game context
+ * @param models struct containing ML model parameters
+ * @param stats Receives the search statistics, NULL to skip collecting them
+ * @return EvalResult with the chosen move, move is -1 if there is nothing to play
+ *
+ * @note Only reads the calling thread's x_board and o_board, the board is left unchanged
+ */
+EvalResult choose_computer_move(const GameContext* context, const AiModels* models, SearchStats* stats)
+{
+    if (!stats) return run_engine(context, models, NULL);
+
+    *stats = (SearchStats){0};
+    active_stats = stats;
+    const double start = now_seconds();
+
+    const EvalResult result = run_engine(context, models, stats);
+
+    stats->wall_time = now_seconds() - start;
+    active_stats = NULL;
+
+    // Model engines only look one ply ahead
+    if (stats->max_ply == 0 && stats->nodes > 0) stats->max_ply = 1;
+    stats->effective_branching = stats->max_ply > 0 ? pow((double)stats->nodes, 1.0 / stats->max_ply) : 0;
+    return result;
+}
+
+/**
+ * @brief Formats search statistics as a single log line
+ *
+ * @param stats Statistics to format
+ * @param buffer Output buffer
+ * @param size Size of the output buffer
+ */
+void format_search_stats(const SearchStats* stats, char* buffer, const size_t size)
+{
+    int written = snprintf(buffer, size,
+                           "nodes=%llu leaves=%llu cutoffs=%llu tt_hits=%llu depth=%d ebf=%.2f time=%.3fms by_move=[",
+                           (unsigned long long)stats->nodes, (unsigned long long)stats->leaf_evals,
+                           (unsigned long long)stats->cutoffs, (unsigned long long)stats->tt_hits, stats->max_ply,
+                           stats->effective_branching, stats->wall_time * 1000.0);
+
+    for (int i = 0; i < 9 && written > 0 && (size_t)written < size; i++)
+    {
+        written += snprintf(buffer + written, size - written, i < 8 ? "%llu " : "%llu]",
+                            (unsigned long long)stats->cutoffs_by_move[i]);
     }
+}
+
+/**
+ * @brief Execute computer's move using various algorithms selected by current game difficulty
+ *
+ * @param context Current game context
+ * @param models struct containing ML model parameters
+ */
+void computer_move(const GameContext* context, const AiModels* models) {
+    const EvalResult result = choose_computer_move(context, models, NULL);
 
     if (result.move != -1)
     {
         const int row = result.move / 3;
         const int col = result.move % 3;
-        set_cell(row, col, computer_player);
+        set_cell(row, col, get_computer_player(context));
     }
 }
-
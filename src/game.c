@@ -1,7 +1,10 @@
+#include <ai_worker.h>
 #include <game.h>
+#include <stdio.h>
+#include <ui_text.h>
 
-uint16_t x_board;
-uint16_t o_board;
+_Thread_local uint16_t x_board;
+_Thread_local uint16_t o_board;
 player_t current_player;
 
 
@@ -13,10 +16,12 @@ player_t current_player;
  * @param context Pointer to game's current context data
  *
  * @details
- * This function resets the relevant variables to prep for the next game
+ * This function resets the relevant variables to prep for the next game,
+ * a search still running for the previous game is cancelled
  */
 void initialize_game(const GameResources* res, GameContext* context)
 {
+    ai_worker_cancel(context->ai_worker);
     x_board = 0;
     o_board = 0;
     context->state = GAME_STATE_PLAYING;
@@ -248,6 +253,35 @@ void update_game_state_score(GameContext *context)
 }
 
 
+/**
+ * A score label is only reformatted when its value or prefix changes, so steady-state
+ * frames draw the already formatted strings.
+ */
+typedef struct {
+    const char* prefix;
+    int value;
+    char text[32];
+} ScoreLabel;
+
+/**
+ * @brief Returns the formatted text of a score label, reformatting it if the value changed
+ *
+ * @param label Pointer to the label
+ * @param prefix Text shown before the score
+ * @param value Score to display
+ * @return Formatted label text
+ */
+static const char* score_label_text(ScoreLabel* label, const char* prefix, const int value)
+{
+    if (label->prefix != prefix || label->value != value)
+    {
+        snprintf(label->text, sizeof(label->text), "%s: %d", prefix, value);
+        label->prefix = prefix;
+        label->value = value;
+    }
+    return label->text;
+}
+
 /**
  * @brief displays current scores
  *
@@ -259,19 +293,15 @@ void update_game_state_score(GameContext *context)
  */
 void display_score(const GameContext *context)
 {
-    if (context->computer_enabled)
-    {
-        // Display scores for one-player mode
-        DrawText(TextFormat("Human: %d", context->p1_score), 10, 100, 40, BLACK);
-        DrawText(TextFormat("Computer: %d", context->p2_score), 760, 100, 40, BLACK);
-    }
-    else
-    {
-        // Display scores for two-player mode
-        DrawText(TextFormat("Player 1: %d", context->p1_score), 10, 100, 40, BLACK);
-        DrawText(TextFormat("Player 2: %d", context->p2_score), 760, 100, 40, BLACK);
-    }
+    static ScoreLabel p1_label = {0}, p2_label = {0}, draw_label = {0};
+
+    // One-player mode shows Human and Computer, two-player mode shows Player 1 and Player 2
+    const char* p1_prefix = context->computer_enabled ? "Human" : "Player 1";
+    const char* p2_prefix = context->computer_enabled ? "Computer" : "Player 2";
+
+    draw_ui_text(score_label_text(&p1_label, p1_prefix, context->p1_score), 10, 100, 40, BLACK);
+    draw_ui_text(score_label_text(&p2_label, p2_prefix, context->p2_score), 760, 100, 40, BLACK);
 
     // Display the number of games that ended in a draw
-    DrawText(TextFormat("Draws: %d", context->draw_score), 410, 100, 40, BLACK);
-}
\ No newline at end of file
+    draw_ui_text(score_label_text(&draw_label, "Draws", context->draw_score), 410, 100, 40, BLACK);
+}
@@ -1,17 +1,19 @@
-// extern global variable defined in C
+// extern thread-local global variable defined in C
 .extern x_board
 .extern o_board
 
 .global check_draw
 check_draw:
-    adrp x0, x_board                // Load the page address of x_board into x0
-    add x0, x0, :lo12:x_board       // Calculate the full address of x_board
-    ldrh w0, [x0]                   // Load half word (16 bits) into w0
+    mrs x2, tpidr_el0                           // Load the thread pointer, boards are thread-local
 
+    add x0, x2, #:tprel_hi12:x_board, lsl #12   // Add the high 12 bits of x_board's offset in the TLS block
+    add x0, x0, #:tprel_lo12_nc:x_board         // Add the low 12 bits to get this thread's x_board
+    ldrh w0, [x0]                               // Load half word (16 bits) into w0
 
-    adrp x1, o_board                // Load the page address of o_board into x1
-    add x1, x1, :lo12:o_board       // Calculate the full address of o_board
-    ldrh w1, [x1]                   // Load half word (16 bits) into w1
+
+    add x1, x2, #:tprel_hi12:o_board, lsl #12   // Add the high 12 bits of o_board's offset in the TLS block
+    add x1, x1, #:tprel_lo12_nc:o_board         // Add the low 12 bits to get this thread's o_board
+    ldrh w1, [x1]                               // Load half word (16 bits) into w1
 
     orr w0, w0, w1 // Bitwise OR: x0 = x0 | x1 to combine boards
 
@@ -1,33 +1,26 @@
 #include "handlers.h"
 
+#include <ai_worker.h>
+#include <audio.h>
 #include <buttons.h>
 #include <computer.h>
 #include <render.h>
 
 /**
- * @brief Handle mouse clicks during active game play
- *
- * Manages player moves, game state transitions, and computer turns
+ * @brief Runs the action of the button clicked on a screen
  *
  * @param click_pos Click position
  * @param resources Game asset resources
  * @param context Current game context
- * @param buttons Button array
- * @param count Number of buttons in array
+ * @param screen Screen whose buttons can be clicked
  */
-void handle_clicks(const Vector2 click_pos, const GameResources* resources, GameContext* context, const Button* buttons, const size_t count)
+void handle_clicks(const Vector2 click_pos, const GameResources* resources, GameContext* context,
+                   const UiScreenId screen)
 {
-    for (int i = 0; i < count; i++)
+    const Button* btn = ui_hit_test(screen, click_pos);
+    if (btn)
     {
-        const Button btn = buttons[i];
-        if (btn.rect)
-        {
-            if (CheckCollisionPointRec(click_pos, *btn.rect) &&
-                IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                btn.action(resources, context);
-            }
-        }
+        btn->action(resources, context);
     }
 }
 
@@ -46,10 +39,11 @@ void handle_game_click(const Vector2 mouse_pos, const GameResources* resources,
     const int row = ((int)mouse_pos.y - context->grid.start_y) / context->grid.cell_size;
     const int col = ((int)mouse_pos.x - context->grid.start_x) / context->grid.cell_size;
 
-    // Check if click is within board and cell is empty
-    if (row >= 0 && row < 3 && col >= 0 && col < 3 && is_cell_empty(row, col))
+    // Check if click is within board and cell is empty, the board is locked while the computer thinks
+    if (!ai_worker_busy(context->ai_worker) &&
+        row >= 0 && row < 3 && col >= 0 && col < 3 && is_cell_empty(row, col))
     {
-        PlaySound(resources->fx_symbol);
+        play_sfx(SFX_SYMBOL);
         set_cell(row, col, current_player);
 
         // Update game state score after player move
@@ -58,13 +52,13 @@ void handle_game_click(const Vector2 mouse_pos, const GameResources* resources,
         // Play specific sounds based on game state
         if (context->state == GAME_STATE_DRAW)
         {
-            PlaySound(resources->fx_draw);
+            play_sfx(SFX_DRAW);
         }
         else if (context->state == GAME_STATE_P1_WIN || context->state == GAME_STATE_P2_WIN)
         {
             if (!is_computer_win(context))
             {
-                PlaySound(resources->fx_win);
+                play_sfx(SFX_WIN);
             }
         }
         else
@@ -72,30 +66,11 @@ void handle_game_click(const Vector2 mouse_pos, const GameResources* resources,
             // Toggle to the next player if the game is still ongoing
             current_player = current_player == PLAYER_X ? PLAYER_O : PLAYER_X;
         }
-        // Handle computer move if enabled and it's the computer's turn
+        // Hand the computer's turn to the AI worker, the move is applied once it is ready
         if (context->computer_enabled &&
             current_player == get_computer_player(context))
         {
-            computer_move(context, resources->models);
-            PlaySound(resources->fx_symbol);
-
-            // Update game state score after computer move
-            update_game_state_score(context);
-
-            // Play specific sounds based on game state
-            if (context->state == GAME_STATE_DRAW)
-            {
-                PlaySound(resources->fx_draw);
-            }
-            else if (context->state == GAME_STATE_P2_WIN)
-            {
-                PlaySound(resources->fx_win);
-            }
-            else
-            {
-                // Toggle back to Player X if the game is still ongoing
-                current_player = current_player == PLAYER_X ? PLAYER_O : PLAYER_X;
-            }
+            ai_worker_submit(context->ai_worker, context);
         }
     }
     const Rectangle audio_ico_rect = calc_music_icon_rect(context, resources);
@@ -105,11 +80,46 @@ void handle_game_click(const Vector2 mouse_pos, const GameResources* resources,
     }
     else
     {
-        handle_clicks(mouse_pos, resources, context, IN_GAME_BUTTONS, 1);
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_IN_GAME);
     }
 }
 
 
+/**
+ * @brief Applies a move finished by the AI worker
+ *
+ * @param resources Game asset resources
+ * @param context Current game context
+ * @param result Move chosen by the computer
+ */
+void handle_computer_move(const GameResources* resources, GameContext* context, const EvalResult result)
+{
+    if (context->state != GAME_STATE_PLAYING) return;
+
+    if (result.move != -1)
+    {
+        set_cell(result.move / 3, result.move % 3, get_computer_player(context));
+    }
+    play_sfx(SFX_SYMBOL);
+
+    // Update game state score after computer move
+    update_game_state_score(context);
+
+    // Play specific sounds based on game state
+    if (context->state == GAME_STATE_DRAW)
+    {
+        play_sfx(SFX_DRAW);
+    }
+    else if (context->state == GAME_STATE_P2_WIN)
+    {
+        play_sfx(SFX_WIN);
+    }
+    else
+    {
+        // Toggle back to the human if the game is still ongoing
+        current_player = current_player == PLAYER_X ? PLAYER_O : PLAYER_X;
+    }
+}
 
 void handle_music_toggle(const GameResources* resources, GameContext* context)
 {
@@ -117,11 +127,11 @@ void handle_music_toggle(const GameResources* resources, GameContext* context)
 
     if (context->audio_disabled)
     {
-        StopMusicStream(resources->background_music);
+        stop_music();
     }
     else
     {
-        PlayMusicStream(resources->background_music);
+        play_music();
     }
 }
 
@@ -141,6 +151,6 @@ void handle_menu_click(const Vector2 mouse_pos, const GameResources* resources,
         handle_music_toggle(resources, context);
     } else
     {
-        handle_clicks(mouse_pos, resources, context, MAIN_MENU_BUTTONS, 4);
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_MAIN_MENU);
     }
 }
@@ -0,0 +1,41 @@
+/**
+ * @file layout.c
+ * @brief Screen layout, recomputed in one pass per resize
+ *
+ * Every resize bumps the layout generation and rebuilds the grid, popup boxes and
+ * button widgets together. Anything laid out records the generation it was
+ * computed for, so steady-state frames only compare two integers.
+ */
+#include <layout.h>
+#include <memo.h>
+#include <menu.h>
+#include <ui_tree.h>
+#include <utils.h>
+
+/**
+ * @brief Starts a new layout generation and lays out every screen element for it
+ *
+ * @param context Pointer to the current game context
+ *
+ * @details Call once at startup and once per resize
+ */
+void update_layout(GameContext* context)
+{
+    Layout* layout = &context->layout;
+    layout->generation++;
+    set_memo_generation(layout->generation);
+
+    const int screen_width = GetScreenWidth();
+    const int screen_height = GetScreenHeight();
+
+    update_grid_dimensions(context);
+
+    layout->game_over_box = calculate_centered_box_dimensions(0.5f, 0.4f, screen_height, screen_width,
+                                                              context->memo_cache);
+    layout->exit_box = calculate_centered_box_dimensions(0.5f, 0.3f, screen_height, screen_width,
+                                                         context->memo_cache);
+    layout->mode_choice_box = calculate_centered_box_dimensions(0.5f, 0.4f, screen_height, screen_width,
+                                                                context->memo_cache);
+
+    layout_ui_tree(layout->generation);
+}
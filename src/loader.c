@@ -0,0 +1,233 @@
+/**
+ * @file loader.c
+ * @brief Parallel asset loading
+ *
+ * Worker threads decode and resize the main menu images and open the music stream
+ * while the main thread keeps drawing a loading screen. Everything else is loaded
+ * on first use by the resource manager, sound effects by the audio thread. The worker
+ * finishing the last image also packs the atlas. Only the GPU and audio device
+ * uploads are left for finish_asset_loading() on the main thread. Assets are decoded
+ * from the asset pak when one is open and from the loose files otherwise.
+ */
+#include <arena.h>
+#include <asset_pak.h>
+#include <atlas.h>
+#include <loader.h>
+#include <resource_manager.h>
+#include <ui_text.h>
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+typedef enum {
+    JOB_IMAGE,
+    JOB_MUSIC
+} LoadJobKind;
+
+typedef struct {
+    LoadJobKind kind;
+    const char* path;
+    int slot;   // SpriteId the image is stored in
+} LoadJob;
+
+struct AssetLoader {
+    LoadJob jobs[SPRITE_COUNT + 1];
+    int job_count;
+    int screen_width;   // Window size the sprites are resampled for
+    int screen_height;
+    atomic_int next_job;
+    atomic_int jobs_done;
+    atomic_int images_left;
+
+    // Results, each written by exactly one job before jobs_done is incremented
+    Image images[SPRITE_COUNT];
+    Image atlas_image;
+    Rectangle atlas_sprites[SPRITE_COUNT];
+    Music music;
+
+    pthread_t threads[ASSET_LOADER_THREADS];
+    bool started[ASSET_LOADER_THREADS];
+};
+
+/**
+ * @brief Decodes an image from the asset pak, or from the file when it is not packed
+ */
+Image load_image_asset(const char* path)
+{
+    int size = 0;
+    const unsigned char* data = find_pak_asset(path, &size);
+    return data ? LoadImageFromMemory(GetFileExtension(path), data, size) : LoadImage(path);
+}
+
+/**
+ * @brief Decodes a sound from the asset pak, or from the file when it is not packed
+ */
+Wave load_wave_asset(const char* path)
+{
+    int size = 0;
+    const unsigned char* data = find_pak_asset(path, &size);
+    return data ? LoadWaveFromMemory(GetFileExtension(path), data, size) : LoadWave(path);
+}
+
+/**
+ * @brief Opens a music stream, streaming from the pak without a copy when packed
+ */
+Music load_music_asset(const char* path)
+{
+    int size = 0;
+    const unsigned char* data = find_pak_asset(path, &size);
+    return data ? LoadMusicStreamFromMemory(GetFileExtension(path), data, size) : LoadMusicStream(path);
+}
+
+/**
+ * @brief Runs one decoding job
+ */
+static void run_job(AssetLoader* loader, const LoadJob* job)
+{
+    switch (job->kind)
+    {
+    case JOB_IMAGE:
+    {
+        Image* image = &loader->images[job->slot];
+        *image = load_image_asset(job->path);
+        resample_sprite_image(image, job->slot, loader->screen_width, loader->screen_height);
+
+        // Whoever decodes the last image packs the atlas
+        if (atomic_fetch_sub(&loader->images_left, 1) == 1)
+        {
+            loader->atlas_image = pack_texture_atlas(loader->images, loader->atlas_sprites);
+            for (int i = 0; i < SPRITE_COUNT; i++)
+            {
+                UnloadImage(loader->images[i]);
+            }
+        }
+        break;
+    }
+    case JOB_MUSIC:
+        // Scans the whole MP3 for its length, raylib registers the stream under its audio lock
+        loader->music = load_music_asset(job->path);
+        break;
+    }
+}
+
+/**
+ * @brief Takes jobs until none are left
+ *
+ * @return true if any job was run
+ */
+static bool drain_jobs(AssetLoader* loader)
+{
+    bool ran = false;
+    int index;
+    while ((index = atomic_fetch_add(&loader->next_job, 1)) < loader->job_count)
+    {
+        run_job(loader, &loader->jobs[index]);
+        atomic_fetch_add_explicit(&loader->jobs_done, 1, memory_order_release);
+        ran = true;
+    }
+    return ran;
+}
+
+static void* asset_loader_main(void* arg)
+{
+    drain_jobs(arg);
+    return NULL;
+}
+
+static void add_job(AssetLoader* loader, const LoadJob job)
+{
+    loader->jobs[loader->job_count++] = job;
+}
+
+/**
+ * @brief Queues all asset decoding and starts the worker threads
+ *
+ * @param screen_width Window width, sprites are resampled to their display size for it
+ * @param screen_height Window height
+ * @return Pointer to the loader, NULL if it could not be allocated
+ *
+ * @details Jobs are ordered largest first so the slowest decode starts immediately
+ */
+AssetLoader* start_asset_loader(const int screen_width, const int screen_height)
+{
+    AssetLoader* loader = arena_alloc(&session_arena, MEM_ASSETS, sizeof(AssetLoader));
+    if (!loader) return NULL;
+    loader->screen_width = screen_width;
+    loader->screen_height = screen_height;
+
+    // Before any worker starts, lookups are read-only from here on
+    open_asset_pak();
+
+    add_job(loader, (LoadJob){JOB_MUSIC, "assets/bg_music.mp3"});
+    for (int i = 0; i < SPRITE_COUNT; i++)
+    {
+        add_job(loader, (LoadJob){JOB_IMAGE, sprite_path(i), i});
+    }
+    atomic_store(&loader->images_left, SPRITE_COUNT);
+
+    for (int i = 0; i < ASSET_LOADER_THREADS; i++)
+    {
+        loader->started[i] = pthread_create(&loader->threads[i], NULL, asset_loader_main, loader) == 0;
+        if (!loader->started[i])
+        {
+            // Jobs left over are run by finish_asset_loading()
+            TraceLog(LOG_WARNING, "Failed to start asset loader thread %d", i);
+        }
+    }
+    return loader;
+}
+
+/**
+ * @brief Returns the share of decoding jobs finished, 0.0 - 1.0
+ */
+float asset_loader_progress(AssetLoader* loader)
+{
+    return (float)atomic_load_explicit(&loader->jobs_done, memory_order_acquire) / (float)loader->job_count;
+}
+
+/**
+ * @brief Checks if all decoding jobs have finished
+ */
+bool asset_loader_done(AssetLoader* loader)
+{
+    return atomic_load_explicit(&loader->jobs_done, memory_order_acquire) == loader->job_count;
+}
+
+/**
+ * @brief Waits for the decoding jobs and uploads the results
+ *
+ * @param loader Pointer to the loader, NULL loads everything on this thread
+ * @return GameResources structure
+ *
+ * @details Must run on the thread owning the window and audio device
+ */
+GameResources finish_asset_loading(AssetLoader* loader)
+{
+    GameResources resources = {0};
+
+    if (!loader)
+    {
+        loader = start_asset_loader(GetScreenWidth(), GetScreenHeight());
+        if (!loader) return resources;
+    }
+
+    // Help with whatever is still queued, then wait for the workers
+    drain_jobs(loader);
+    for (int i = 0; i < ASSET_LOADER_THREADS; i++)
+    {
+        if (loader->started[i]) pthread_join(loader->threads[i], NULL);
+    }
+
+    // Uploads, these need the window or audio device
+    resources.atlas = upload_texture_atlas(loader->atlas_image, loader->atlas_sprites);
+
+    resources.background_music = loader->music;
+
+    load_ui_font();
+
+    // Filled in by the resource manager when a mode needs a model
+    resources.models = resource_models();
+
+    return resources;
+}
@@ -6,21 +6,151 @@
  * for the Tic-Tac-Toe game implemented with a text-based user interface.
  */
 
+#include <ai_worker.h>
+#include <arena.h>
+#include <atlas.h>
+#include <audio.h>
+#include <computer.h>
+#include <errno.h>
 #include <render.h>
 #include <handlers.h>
+#include <layout.h>
+#include <loader.h>
+#include <mem_stats.h>
 #include <memo.h>
 #include <menu.h>
 #include <raylib.h>
+#include <redraw.h>
+#include <resource_manager.h>
+#include <server.h>
+#include <spectator.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <update.h>
 #include <uthash.h>
+#include <verify.h>
 
-int main(void)
+#define USAGE "Usage: 1103_tic_tac_toe [--server [socket_path]] [--verify] [--continuous-redraw] " \
+              "[--spectate [boards]] [--resource-budget <KiB>]"
+
+typedef struct {
+    bool server;                 // Headless engine server mode: --server [socket_path]
+    const char* socket_path;
+    bool verify;                 // Exhaustive engine verification: --verify
+    bool continuous_redraw;      // Draw every frame: --continuous-redraw
+    bool spectate;               // Lobby display of engine-vs-engine matches: --spectate [boards]
+    int spectator_boards;
+    size_t resource_budget;      // Cache budget for lazily loaded resources: --resource-budget <KiB>
+} LaunchOptions;
+
+/**
+ * @brief Parses a positive decimal number, rejecting anything else
+ */
+static bool parse_count(const char* text, unsigned long* value)
+{
+    if (text == NULL || *text < '0' || *text > '9') return false;
+    char* end = NULL;
+    errno = 0;
+    *value = strtoul(text, &end, 10);
+    return errno == 0 && *end == '\0' && *value > 0;
+}
+
+/**
+ * @brief Reads the command line, flags may appear in any order and be combined
+ *
+ * @return false on an unknown flag or an invalid value, after logging why
+ */
+static bool parse_launch_options(const int argc, char* argv[], LaunchOptions* options)
+{
+    *options = (LaunchOptions){
+        .socket_path = ENGINE_SERVER_DEFAULT_SOCKET,
+        .spectator_boards = SPECTATOR_DEFAULT_BOARDS,
+        .resource_budget = RESOURCE_BUDGET_DEFAULT,
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        // Optional values are taken when the next argument is not a flag
+        const char* next = i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0 ? argv[i + 1] : NULL;
+        unsigned long value = 0;
+
+        if (strcmp(argv[i], "--server") == 0)
+        {
+            options->server = true;
+            if (next) options->socket_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--verify") == 0)
+        {
+            options->verify = true;
+        }
+        else if (strcmp(argv[i], "--continuous-redraw") == 0)
+        {
+            options->continuous_redraw = true;
+        }
+        else if (strcmp(argv[i], "--spectate") == 0)
+        {
+            options->spectate = true;
+            if (!next) continue;
+            if (!parse_count(next, &value) || value > SPECTATOR_MAX_BOARDS)
+            {
+                TraceLog(LOG_ERROR, "--spectate expects 1 to %d boards, got \"%s\"", SPECTATOR_MAX_BOARDS, next);
+                return false;
+            }
+            options->spectator_boards = (int)value;
+            i++;
+        }
+        else if (strcmp(argv[i], "--resource-budget") == 0)
+        {
+            if (!parse_count(next, &value) || value > SIZE_MAX / 1024)
+            {
+                TraceLog(LOG_ERROR, "--resource-budget expects a size in KiB, got \"%s\"", next ? next : "");
+                return false;
+            }
+            options->resource_budget = (size_t)value * 1024;
+            i++;
+        }
+        else
+        {
+            TraceLog(LOG_ERROR, "Unknown option %s", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(const int argc, char* argv[])
 {
+    LaunchOptions options;
+    if (!parse_launch_options(argc, argv, &options))
+    {
+        TraceLog(LOG_ERROR, USAGE);
+        return EXIT_FAILURE;
+    }
+
+    if (options.server)
+    {
+        return run_engine_server(options.socket_path);
+    }
+
+    // Exit status reports the outcome
+    if (options.verify)
+    {
+        return run_engine_verification();
+    }
+
     // Initialization
     //--------------------------------------------------------------------------------------
     const int screen_width = 1000;
     const int screen_height = 1000;
 
+    // Frames are only redrawn when something changed, --continuous-redraw draws every frame
+    const bool event_driven_redraw = !options.continuous_redraw;
+    const bool spectate = options.spectate;
+    const int spectator_boards = options.spectator_boards;
+
+    init_resource_manager(options.resource_budget);
+
 
     MemoCache* memo_cache = init_memo_cache();
     if (!memo_cache) {
@@ -31,16 +161,18 @@ int main(void)
     GridDimensions default_grid = {0};
 
     GameContext context = {
-        .needs_recalculation = false,
         .exit_flag = false,
         .grid = default_grid,
         .state = GAME_STATE_MENU,
         .selected_game_mode = TWO_PLAYER,
         .player_1 = PLAYER_X,
         .computer_enabled = false,
+        .pondering_enabled = true,
+        .search_stats_enabled = false,
+        .memory_stats_enabled = false,
         .audio_disabled = false,
         .transition = {
-            .start_time = 0,
+            .elapsed = 0,
             .active = false
         },
         .start_screen_shown = false,
@@ -48,6 +180,8 @@ int main(void)
         .p2_score = 0,
         .draw_score = 0,
         .memo_cache = memo_cache,
+        .ai_worker = NULL,
+        .spectator = NULL,
     };
 
     const UiOptions render_options = {
@@ -58,72 +192,86 @@ int main(void)
 
     InitWindow(screen_width, screen_height, "THE BEST --- Tic Tac Toe");
     InitAudioDevice();
+    SetTargetFPS(60);
 
-    GameResources resources = load_game_resources();
+    // Assets are decoded on worker threads while the loading screen is drawn, GetTime() starts at InitWindow
+    AssetLoader* loader = start_asset_loader(screen_width, screen_height);
+    bool loading_frame_drawn = false;
+    while (loader && !context.exit_flag && !asset_loader_done(loader))
+    {
+        if (WindowShouldClose()) context.exit_flag = true;
 
-    update_grid_dimensions(&context);
+        BeginDrawing();
+        render_loading_screen(asset_loader_progress(loader), &render_options);
+        EndDrawing();
 
-    SetTargetFPS(60);
-    PlayMusicStream(resources.background_music);
-    while (!context.exit_flag)
-    {
-        // Check for window resize event
-        if (IsWindowResized()) {
-            context.needs_recalculation = true;
-            update_grid_dimensions(&context);
+        if (!loading_frame_drawn)
+        {
+            TraceLog(LOG_INFO, "Startup: loading screen after %.0f ms", GetTime() * 1000.0);
+            loading_frame_drawn = true;
         }
-        UpdateMusicStream(resources.background_music);
+    }
 
-        // Click handling
-        const Vector2 mouse_pos = GetMousePosition();
-        if (WindowShouldClose()) context.exit_flag = true;
-        switch (context.state)
-        {
-        case GAME_STATE_MENU:
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                handle_menu_click(mouse_pos, &resources, &context);
-            }
-            break;
-        case GAME_STATE_PLAYING:
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && context.start_screen_shown)
-            {
-                handle_game_click(mouse_pos, &resources, &context);
-            }
-            break;
-        case GAME_STATE_P1_WIN:
-        case GAME_STATE_P2_WIN:
-        case GAME_STATE_DRAW:
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                handle_clicks(mouse_pos, &resources, &context, GAME_OVER_BUTTONS, 2);
+    GameResources resources = finish_asset_loading(loader);
+    TraceLog(LOG_INFO, "Startup: assets ready after %.0f ms", GetTime() * 1000.0);
 
-            }
-            break;
+    context.ai_worker = init_ai_worker(resources.models);
+    if (!context.ai_worker) {
+        TraceLog(LOG_ERROR, "Failed to start AI worker\n");
+        unload_game_resources(&resources);
+        cleanup_memo_cache(context.memo_cache);
+        CloseAudioDevice();
+        CloseWindow();
+        free_arena(&session_arena);
+        return EXIT_FAILURE;
+    }
 
+    if (spectate) {
+        // Every engine plays on the wall, hold both models for its lifetime
+        acquire_resource(RES_NEURAL_NETWORK);
+        acquire_resource(RES_BAYES_MODEL);
+        context.spectator = init_spectator_wall(resources.models, spectator_boards);
+        if (context.spectator) context.state = GAME_STATE_SPECTATOR;
+        else TraceLog(LOG_WARNING, "Failed to start the spectator wall");
+    }
 
-        case GAME_STATE_EXIT:
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                handle_clicks(mouse_pos, &resources, &context, EXIT_CONFIRMATION_BUTTONS, 2);
-            }
-            break;
+    update_layout(&context);
 
-        case MENU_DIFF_CHOICE:
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                handle_clicks(mouse_pos, &resources, &context, GAME_MODE_BUTTONS, 4);
-            }
-            break;
-        case MENU_INSTRUCTIONS:
-            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-            {
-                handle_clicks(mouse_pos, &resources, &context, INSTRUCTIONS_BUTTONS, 1);
-            }
-            break;
-        default:
-            break;
+    RedrawTracker redraw_tracker;
+    init_redraw_tracker(&redraw_tracker);
+
+    SimClock sim_clock;
+    init_sim_clock(&sim_clock);
+
+    bool first_frame_drawn = false;
+    // From here on the music stream belongs to the audio thread
+    if (!init_audio(&resources.background_music)) TraceLog(LOG_WARNING, "Continuing without sound");
+    play_music();
+    while (!context.exit_flag)
+    {
+        // Check for window resize event
+        bool resized = IsWindowResized();
+        if (resized) update_layout(&context);
+        // Sprites follow the window size, resampled once the size has settled
+        if (update_texture_atlas(&resources.atlas, resized))
+        {
+            update_layout(&context); // Layers cached the scaled sprites
+            resized = true;
+        }
+
+        // Update phase, input, timers, transitions and AI completion
+        update_game(&sim_clock, &resources, &context);
+
+        report_render_utilisation(&redraw_tracker, event_driven_redraw);
+        report_mem_usage();
+        if (event_driven_redraw && !frame_needs_redraw(&redraw_tracker, &context, resized))
+        {
+            // Nothing changed, keep the last frame on screen
+            wait_idle_tick(&redraw_tracker);
+            continue;
         }
+
+        // Render phase, only reads state
         BeginDrawing();
         switch (context.state)
         {
@@ -132,7 +280,7 @@ int main(void)
             break;
         case GAME_STATE_PLAYING:
             if (!context.start_screen_shown) {
-                do_game_start_transition(&resources, &render_options, &context);
+                render_game_start_transition(&resources, &render_options, &context);
             } else {
                 render_grid(&resources, &render_options, &context, true);
             }
@@ -140,7 +288,7 @@ int main(void)
         case GAME_STATE_P1_WIN:
         case GAME_STATE_P2_WIN:
         case GAME_STATE_DRAW:
-            do_game_over_transition(&resources, &render_options, &context);
+            render_game_over_transition(&resources, &render_options, &context);
             break;
 
         case MENU_INSTRUCTIONS:
@@ -155,15 +303,36 @@ int main(void)
             render_game_mode_choice(&render_options, &context);
             break;
 
+        case GAME_STATE_SPECTATOR:
+            render_spectator_wall(context.spectator, &render_options);
+            break;
+
         default:
             break;
         }
+        if (context.memory_stats_enabled) render_memory_stats();
         EndDrawing();
+        reset_arena(&frame_arena);
+        note_frame_drawn(&redraw_tracker, &context);
+
+        if (!first_frame_drawn)
+        {
+            TraceLog(LOG_INFO, "Startup: time to first frame %.0f ms", GetTime() * 1000.0);
+            first_frame_drawn = true;
+        }
     }
     // Clean up before exit
+    cleanup_spectator_wall(context.spectator);
+    cleanup_ai_worker(context.ai_worker);
+    cleanup_audio();
+    unload_render_layers();
     unload_game_resources(&resources);
     cleanup_memo_cache(context.memo_cache);
     CloseAudioDevice();
     CloseWindow();
+    TraceLog(LOG_INFO, "Arenas: session peak %zu bytes, frame peak %zu bytes", session_arena.peak, frame_arena.peak);
+    free_arena(&frame_arena);
+    free_arena(&session_arena);
+    log_mem_usage("Memory at exit"); // Anything still held here leaked
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,132 @@
+/**
+ * @file mem_stats.c
+ * @brief Memory accounting per subsystem
+ *
+ * Allocation sites report what they allocate and release, tagged with the owning
+ * subsystem and whether it is CPU or GPU memory. Counters are atomic because the
+ * loader, audio and AI threads allocate too. Each counter keeps the bytes held now,
+ * the high-water mark and every byte ever allocated: current growing over a long
+ * session is a leak, total growing fast is churn.
+ */
+#include <mem_stats.h>
+
+#include <stdatomic.h>
+#include <stdio.h>
+
+typedef struct {
+    atomic_size_t current;
+    atomic_size_t peak;
+    atomic_uint_least64_t total;
+} AtomicMemCounter;
+
+static const char* const SUBSYSTEM_NAMES[MEM_SUBSYSTEM_COUNT] = {
+    [MEM_UI] = "ui",
+    [MEM_MEMO] = "memo",
+    [MEM_ASSETS] = "assets",
+    [MEM_AI] = "ai",
+    [MEM_AUDIO] = "audio",
+};
+
+static AtomicMemCounter counters[MEM_SUBSYSTEM_COUNT][MEM_KIND_COUNT];
+static double last_report = 0.0;
+
+/**
+ * @brief Records an allocation
+ */
+void track_alloc(const MemSubsystem subsystem, const MemKind kind, const size_t bytes)
+{
+    AtomicMemCounter* counter = &counters[subsystem][kind];
+    const size_t current = atomic_fetch_add_explicit(&counter->current, bytes, memory_order_relaxed) + bytes;
+    atomic_fetch_add_explicit(&counter->total, bytes, memory_order_relaxed);
+
+    size_t peak = atomic_load_explicit(&counter->peak, memory_order_relaxed);
+    while (current > peak &&
+           !atomic_compare_exchange_weak_explicit(&counter->peak, &peak, current, memory_order_relaxed,
+                                                  memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Records a release of memory recorded with track_alloc()
+ */
+void track_free(const MemSubsystem subsystem, const MemKind kind, const size_t bytes)
+{
+    atomic_fetch_sub_explicit(&counters[subsystem][kind].current, bytes, memory_order_relaxed);
+}
+
+/**
+ * @brief Estimates the GPU memory of a texture, including its mipmaps
+ */
+size_t texture_bytes(const Texture2D texture)
+{
+    size_t bytes = 0;
+    int width = texture.width;
+    int height = texture.height;
+    for (int level = 0; level < (texture.mipmaps > 0 ? texture.mipmaps : 1); level++)
+    {
+        bytes += (size_t)GetPixelDataSize(width, height, texture.format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+/**
+ * @brief Estimates the GPU memory of a render target, colour plus a 32 bit depth buffer
+ */
+size_t render_texture_bytes(const RenderTexture2D target)
+{
+    if (target.id == 0) return 0;
+    return texture_bytes(target.texture) + (size_t)target.depth.width * (size_t)target.depth.height * 4;
+}
+
+MemCounter get_mem_counter(const MemSubsystem subsystem, const MemKind kind)
+{
+    const AtomicMemCounter* counter = &counters[subsystem][kind];
+    return (MemCounter){
+        atomic_load_explicit(&counter->current, memory_order_relaxed),
+        atomic_load_explicit(&counter->peak, memory_order_relaxed),
+        atomic_load_explicit(&counter->total, memory_order_relaxed),
+    };
+}
+
+const char* mem_subsystem_name(const MemSubsystem subsystem)
+{
+    return SUBSYSTEM_NAMES[subsystem];
+}
+
+/**
+ * @brief Logs one line with every subsystem, in KiB as current/peak/total
+ *
+ * @param label Prefix of the line, e.g. "Memory" or "Memory at exit"
+ */
+void log_mem_usage(const char* label)
+{
+    char line[512];
+    int length = snprintf(line, sizeof(line), "%s (KiB now/peak/total):", label);
+    for (int i = 0; i < MEM_SUBSYSTEM_COUNT && length > 0 && (size_t)length < sizeof(line); i++)
+    {
+        const MemCounter heap = get_mem_counter(i, MEM_HEAP);
+        const MemCounter gpu = get_mem_counter(i, MEM_GPU);
+        length += snprintf(line + length, sizeof(line) - (size_t)length, " %s %zu/%zu/%llu", SUBSYSTEM_NAMES[i],
+                           heap.current / 1024, heap.peak / 1024, (unsigned long long)(heap.total / 1024));
+        if (gpu.peak > 0 && (size_t)length < sizeof(line))
+        {
+            length += snprintf(line + length, sizeof(line) - (size_t)length, " +gpu %zu/%zu/%llu",
+                               gpu.current / 1024, gpu.peak / 1024, (unsigned long long)(gpu.total / 1024));
+        }
+    }
+    TraceLog(LOG_INFO, "%s", line);
+}
+
+/**
+ * @brief Logs the memory line every MEM_REPORT_SECONDS, call once per loop iteration
+ */
+void report_mem_usage(void)
+{
+    const double now = GetTime();
+    if (now - last_report < MEM_REPORT_SECONDS) return;
+    last_report = now;
+    log_mem_usage("Memory");
+}
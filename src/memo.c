@@ -1,17 +1,283 @@
+/**
+ * @file memo.c
+ * @brief Bounded memoization tables
+ *
+ * Each table is one session arena allocation of a fixed number of slots, so lookups
+ * and inserts never touch the heap. Keys are hashed with FNV-1a and probed linearly for at most
+ * MEMO_PROBE_LIMIT slots from their home slot. When that window is full an entry in
+ * it is replaced using CLOCK: every hit sets a slot's reference bit, the hand clears
+ * bits as it sweeps and evicts the first slot without one.
+ *
+ * Layout helpers memoize through DEFINE_MEMO, one table per function. Those tables
+ * are stamped with the layout generation and emptied when it changes, so they only
+ * ever hold entries for the current window size.
+ */
 #include "memo.h"
+#include <arena.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MEMO_SLOT_USED 0x1
+#define MEMO_SLOT_REFERENCED 0x2
+
+typedef struct {
+    uint32_t hash;
+    uint32_t flags;
+} MemoSlotHeader;
+
+#define MEMO_ALIGN(size) (((size) + 7) & ~(size_t)7)
+
+static uint32_t hash_key(const void* key, const size_t size)
+{
+    const unsigned char* bytes = key;
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static MemoSlotHeader* slot_at(const MemoTable* table, const uint32_t index)
+{
+    return (MemoSlotHeader*)(table->slots + (size_t)index * table->slot_size);
+}
+
+static unsigned char* slot_key(MemoSlotHeader* slot)
+{
+    return (unsigned char*)slot + sizeof(MemoSlotHeader);
+}
+
+static unsigned char* slot_value(const MemoTable* table, MemoSlotHeader* slot)
+{
+    return slot_key(slot) + MEMO_ALIGN(table->key_size);
+}
+
+static uint32_t probe_window(const MemoTable* table)
+{
+    return table->capacity < MEMO_PROBE_LIMIT ? table->capacity : MEMO_PROBE_LIMIT;
+}
+
+/**
+ * Allocates a memoization table
+ *
+ * @param table Table to initialise
+ * @param capacity Number of entries, rounded up to a power of two
+ * @param key_size Size of a key in bytes
+ * @param value_size Size of a value in bytes
+ * @return true on success
+ */
+bool init_memo_table(MemoTable* table, uint32_t capacity, const size_t key_size, const size_t value_size)
+{
+    memset(table, 0, sizeof(MemoTable));
+
+    uint32_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+
+    table->key_size = key_size;
+    table->value_size = value_size;
+    table->slot_size = sizeof(MemoSlotHeader) + MEMO_ALIGN(key_size) + MEMO_ALIGN(value_size);
+    table->capacity = rounded;
+    table->slots = arena_calloc(&session_arena, MEM_MEMO, rounded, table->slot_size);
+    return table->slots != NULL;
+}
+
+/**
+ * Detaches a table, its slots are returned with the session arena
+ */
+void cleanup_memo_table(MemoTable* table)
+{
+    table->slots = NULL;
+    table->capacity = 0;
+}
+
+/**
+ * Empties a table, the counters are kept
+ */
+void clear_memo_table(MemoTable* table)
+{
+    if (table->slots) memset(table->slots, 0, (size_t)table->capacity * table->slot_size);
+}
+
+/**
+ * Looks up a key
+ *
+ * @param table Table to search
+ * @param key Key of table->key_size bytes
+ * @param value Receives the value on a hit
+ * @return true on a hit
+ */
+bool memo_table_get(MemoTable* table, const void* key, void* value)
+{
+    if (table->capacity == 0) return false;
+
+    const uint32_t hash = hash_key(key, table->key_size);
+    const uint32_t window = probe_window(table);
+    for (uint32_t i = 0; i < window; i++)
+    {
+        MemoSlotHeader* slot = slot_at(table, (hash + i) & (table->capacity - 1));
+
+        // Entries are only ever replaced in place, so an empty slot ends the probe
+        if (!(slot->flags & MEMO_SLOT_USED)) break;
+        if (slot->hash == hash && memcmp(slot_key(slot), key, table->key_size) == 0)
+        {
+            slot->flags |= MEMO_SLOT_REFERENCED;
+            memcpy(value, slot_value(table, slot), table->value_size);
+            table->stats.hits++;
+            return true;
+        }
+    }
+
+    table->stats.misses++;
+    return false;
+}
+
+/**
+ * Stores a value for a key that memo_table_get() missed
+ *
+ * @param table Table to insert into
+ * @param key Key of table->key_size bytes
+ * @param value Value of table->value_size bytes
+ */
+void memo_table_put(MemoTable* table, const void* key, const void* value)
+{
+    if (table->capacity == 0) return;
+
+    const uint32_t hash = hash_key(key, table->key_size);
+    const uint32_t window = probe_window(table);
+    const uint32_t mask = table->capacity - 1;
+
+    MemoSlotHeader* target = NULL;
+    for (uint32_t i = 0; i < window && !target; i++)
+    {
+        MemoSlotHeader* slot = slot_at(table, (hash + i) & mask);
+        if (!(slot->flags & MEMO_SLOT_USED)) target = slot;
+    }
+
+    if (!target)
+    {
+        // CLOCK over the probe window, two sweeps always find an unreferenced slot
+        for (uint32_t step = 0; step < 2 * window; step++)
+        {
+            MemoSlotHeader* slot = slot_at(table, (hash + table->clock_hand++ % window) & mask);
+            if (slot->flags & MEMO_SLOT_REFERENCED)
+            {
+                slot->flags &= ~MEMO_SLOT_REFERENCED;
+                continue;
+            }
+            target = slot;
+            break;
+        }
+        table->stats.evictions++;
+    }
+
+    target->hash = hash;
+    target->flags = MEMO_SLOT_USED;
+    memcpy(slot_key(target), key, table->key_size);
+    memcpy(slot_value(table, target), value, table->value_size);
+}
+
+// Functions whose table has been allocated, most recently first
+static MemoFunction* memo_functions = NULL;
+static uint32_t memo_generation = 0;
+
+/**
+ * Sets the layout generation memoized functions are keyed on
+ *
+ * @param generation Current layout generation
+ */
+void set_memo_generation(const uint32_t generation)
+{
+    memo_generation = generation;
+}
+
+/**
+ * Allocates a function's table on first use and drops entries of older layouts
+ *
+ * @return true if the table can be used
+ */
+static bool prepare_memo_function(MemoFunction* function)
+{
+    if (!function->table.slots)
+    {
+        if (!init_memo_table(&function->table, function->capacity, function->key_size, function->value_size))
+        {
+            return false;
+        }
+        function->generation = memo_generation;
+        function->next = memo_functions;
+        memo_functions = function;
+    }
+
+    if (function->generation != memo_generation)
+    {
+        clear_memo_table(&function->table);
+        function->generation = memo_generation;
+    }
+    return true;
+}
+
+/**
+ * Looks up a memoized result for the current layout generation, use the typed
+ * name_memo_get() defined by DEFINE_MEMO instead
+ */
+bool memo_function_get(MemoFunction* function, const void* key, void* value)
+{
+    if (!prepare_memo_function(function))
+    {
+        function->table.stats.misses++;
+        return false;
+    }
+    return memo_table_get(&function->table, key, value);
+}
+
+/**
+ * Stores a result for the current layout generation, use the typed name_memo_put()
+ * defined by DEFINE_MEMO instead
+ */
+void memo_function_put(MemoFunction* function, const void* key, const void* value)
+{
+    if (prepare_memo_function(function)) memo_table_put(&function->table, key, value);
+}
+
+static void log_memo_stats(const char* name, const MemoTable* table)
+{
+    const uint64_t lookups = table->stats.hits + table->stats.misses;
+    TraceLog(LOG_INFO, "Memo %s: %llu hits, %llu misses (%.1f%% hit rate), %llu evictions", name,
+             (unsigned long long)table->stats.hits, (unsigned long long)table->stats.misses,
+             lookups ? 100.0 * (double)table->stats.hits / (double)lookups : 0.0,
+             (unsigned long long)table->stats.evictions);
+}
+
+/**
+ * Logs the hit rate of every memoized function
+ */
+void report_memo_stats(void)
+{
+    for (const MemoFunction* function = memo_functions; function; function = function->next)
+    {
+        log_memo_stats(function->name, &function->table);
+    }
+}
 
 MemoCache* init_memo_cache(void)
 {
-    MemoCache* cache = malloc(sizeof(MemoCache));
-    if (cache)
+    MemoCache* cache = arena_alloc(&session_arena, MEM_MEMO, sizeof(MemoCache));
+    if (!cache) return NULL;
+
+    if (!init_memo_table(&cache->boxes, MEMO_BOX_CAPACITY, sizeof(BoxKey), sizeof(BoxDimensions)) ||
+        !init_memo_table(&cache->text_widths, MEMO_TEXT_CAPACITY, sizeof(TextKey), sizeof(int)))
     {
-        cache->box_cache = NULL;
+        cleanup_memo_cache(cache);
+        return NULL;
     }
     return cache;
 }
 
 /**
- * Deallocates memory for a memoization cache
+ * Logs the cache statistics and detaches every table, the memory is returned with
+ * the session arena
  *
  * @param cache Pointer to MemoCache structure to be freed
  */
@@ -19,14 +285,19 @@ void cleanup_memo_cache(MemoCache* cache)
 {
     if (!cache) return;
 
-    BoxCache *current_box, *tmp_box;
-    HASH_ITER(hh, cache->box_cache, current_box, tmp_box)
-    {
-        HASH_DEL(cache->box_cache, current_box);
-        free(current_box);
-    }
+    if (cache->boxes.slots) log_memo_stats("boxes", &cache->boxes);
+    if (cache->text_widths.slots) log_memo_stats("text widths", &cache->text_widths);
 
-    free(cache);
+    cleanup_memo_table(&cache->boxes);
+    cleanup_memo_table(&cache->text_widths);
 
-    cache = NULL;
+    // Function tables live as long as the cache that drives the layout
+    report_memo_stats();
+    while (memo_functions)
+    {
+        MemoFunction* function = memo_functions;
+        memo_functions = function->next;
+        cleanup_memo_table(&function->table);
+        function->next = NULL;
+    }
 }
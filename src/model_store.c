@@ -0,0 +1,355 @@
+/**
+ * @file model_store.c
+ * @brief AI models shared read-only between game instances on one host
+ *
+ * The first instance to need a model creates a POSIX shared memory object, reads
+ * every model into it, stamps the header and publishes it by setting its state to
+ * MODEL_STORE_READY. The mapping is then made read-only. Later instances map the
+ * same object read-only, so all of them use the same physical pages.
+ *
+ * Before using a store an instance checks the handshake: the magic, the version,
+ * the header and section layout, the fingerprint of the assets and a checksum of
+ * every section. A store that fails any check, or that is still not ready after
+ * MODEL_STORE_ATTACH_TIMEOUT_MS, is not used: its name is unlinked and rebuilt once,
+ * then the caller falls back to loading a private copy. Stores are left behind on
+ * exit so the next instance attaches instead of rebuilding; changed assets give a
+ * new fingerprint and so a new name.
+ *
+ * Stores are private to a user: the name carries the effective uid and the object
+ * is created with mode 0600. A store is only mapped if it is owned by this user and
+ * nobody else can write it, so another account cannot plant models under the name.
+ * Such an object is left alone and the private copies are used.
+ */
+#include <model_store.h>
+#include <asset_pak.h>
+#include <mem_stats.h>
+#include <raylib.h>
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define MODEL_STORE_NAME_LEN 64
+
+static const char* const MODEL_PATHS[MODEL_SECTION_COUNT] = {
+    [MODEL_SECTION_NEURAL_NETWORK] = "assets/nn_weights.dat",
+    [MODEL_SECTION_BAYES] = "assets/bayes_model.dat",
+};
+
+static const size_t MODEL_SIZES[MODEL_SECTION_COUNT] = {
+    [MODEL_SECTION_NEURAL_NETWORK] = sizeof(NeuralNetwork),
+    [MODEL_SECTION_BAYES] = sizeof(BayesModel),
+};
+
+static struct {
+    bool attached;      // Attaching is only tried once
+    unsigned char* base; // NULL when no store could be used
+    size_t size;
+} store = {0};
+
+static uint64_t fnv1a(uint64_t hash, const void* data, const size_t size)
+{
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+#define FNV1A_OFFSET 14695981039346656037ull
+
+/**
+ * @brief Hashes the model assets and the layout they are loaded into
+ */
+static uint64_t model_fingerprint(void)
+{
+    uint64_t hash = FNV1A_OFFSET;
+    const uint32_t version = MODEL_STORE_VERSION;
+    hash = fnv1a(hash, &version, sizeof(version));
+    hash = fnv1a(hash, MODEL_SIZES, sizeof(MODEL_SIZES));
+
+    for (int i = 0; i < MODEL_SECTION_COUNT; i++)
+    {
+        hash = fnv1a(hash, MODEL_PATHS[i], strlen(MODEL_PATHS[i]) + 1);
+
+        AssetReader reader;
+        if (!open_asset_reader(&reader, MODEL_PATHS[i])) continue;
+        unsigned char chunk[4096];
+        size_t read;
+        while ((read = read_asset(&reader, chunk, sizeof(chunk))) > 0)
+        {
+            hash = fnv1a(hash, chunk, read);
+        }
+        close_asset_reader(&reader);
+    }
+    return hash;
+}
+
+/**
+ * @brief Places every section after the header, returns the total size
+ */
+static size_t layout_sections(ModelSection sections[MODEL_SECTION_COUNT])
+{
+    size_t offset = sizeof(ModelStoreHeader);
+    for (int i = 0; i < MODEL_SECTION_COUNT; i++)
+    {
+        offset = (offset + MODEL_STORE_ALIGNMENT - 1) & ~(size_t)(MODEL_STORE_ALIGNMENT - 1);
+        sections[i].offset = offset;
+        sections[i].size = MODEL_SIZES[i];
+        offset += MODEL_SIZES[i];
+    }
+    return offset;
+}
+
+static uint64_t section_checksum(const unsigned char* base, const ModelStoreHeader* header)
+{
+    uint64_t hash = FNV1A_OFFSET;
+    for (int i = 0; i < MODEL_SECTION_COUNT; i++)
+    {
+        const ModelSection* section = &header->sections[i];
+        if (section->offset != 0) hash = fnv1a(hash, base + section->offset, section->size);
+    }
+    return hash;
+}
+
+/**
+ * @brief Checks the handshake of a ready store
+ */
+static bool validate_store(const unsigned char* base, const size_t size, const uint64_t fingerprint)
+{
+    const ModelStoreHeader* header = (const ModelStoreHeader*)base;
+    ModelSection expected[MODEL_SECTION_COUNT];
+    const size_t expected_size = layout_sections(expected);
+
+    if (header->magic != MODEL_STORE_MAGIC || header->version != MODEL_STORE_VERSION ||
+        header->header_size != sizeof(ModelStoreHeader) || header->total_size != size ||
+        size != expected_size || header->fingerprint != fingerprint)
+    {
+        return false;
+    }
+    for (int i = 0; i < MODEL_SECTION_COUNT; i++)
+    {
+        const ModelSection* section = &header->sections[i];
+        if (section->size != expected[i].size) return false;
+        if (section->offset != 0 && section->offset != expected[i].offset) return false;
+    }
+    return header->checksum == section_checksum(base, header);
+}
+
+#ifndef _WIN32
+static void sleep_ms(const long ms)
+{
+    const struct timespec delay = {0, ms * 1000000L};
+    nanosleep(&delay, NULL);
+}
+
+/**
+ * @brief Creates the store and reads every model into it
+ *
+ * @return true if this instance built the store, false if it already exists or failed
+ */
+static bool build_store(const char* name, const uint64_t fingerprint)
+{
+    const int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+
+    ModelSection sections[MODEL_SECTION_COUNT];
+    const size_t size = layout_sections(sections);
+    unsigned char* base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0)
+    {
+        base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        TraceLog(LOG_WARNING, "Failed to create shared model store %s", name);
+        shm_unlink(name);
+        return false;
+    }
+
+    // Zero filled by ftruncate, so the state reads MODEL_STORE_BUILDING until published
+    ModelStoreHeader* header = (ModelStoreHeader*)base;
+    header->magic = MODEL_STORE_MAGIC;
+    header->version = MODEL_STORE_VERSION;
+    header->header_size = sizeof(ModelStoreHeader);
+    header->fingerprint = fingerprint;
+    header->total_size = size;
+    memcpy(header->sections, sections, sizeof(sections));
+
+    if (!read_model((NeuralNetwork*)(base + sections[MODEL_SECTION_NEURAL_NETWORK].offset)))
+    {
+        header->sections[MODEL_SECTION_NEURAL_NETWORK].offset = 0;
+    }
+    if (!read_naive_bayes((BayesModel*)(base + sections[MODEL_SECTION_BAYES].offset)))
+    {
+        header->sections[MODEL_SECTION_BAYES].offset = 0;
+    }
+    header->checksum = section_checksum(base, header);
+    atomic_store_explicit(&header->state, MODEL_STORE_READY, memory_order_release);
+
+    mprotect(base, size, PROT_READ);
+    store.base = base;
+    store.size = size;
+    track_alloc(MEM_AI, MEM_HEAP, size);
+    TraceLog(LOG_INFO, "Built shared model store %s, %zu bytes", name, size);
+    return true;
+}
+
+/**
+ * @brief Maps a store built by another instance and checks its handshake
+ *
+ * @param retry Set when the store is unusable or was removed meanwhile, so it can be rebuilt
+ * @return true if the store is attached
+ */
+static bool open_store(const char* name, const uint64_t fingerprint, bool* retry)
+{
+    *retry = false;
+    const int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        *retry = errno == ENOENT;
+        return false;
+    }
+
+    // Created by someone else, or writable by others, the contents cannot be trusted
+    struct stat st = {0};
+    if (fstat(fd, &st) != 0 || st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+    {
+        TraceLog(LOG_WARNING, "Shared model store %s is not private to this user, ignoring it", name);
+        close(fd);
+        return false;
+    }
+
+    ModelSection sections[MODEL_SECTION_COUNT];
+    const size_t size = layout_sections(sections);
+
+    // The builder sizes the object right after creating it
+    int waited = 0;
+    while (fstat(fd, &st) == 0 && (size_t)st.st_size < sizeof(ModelStoreHeader) &&
+           waited < MODEL_STORE_ATTACH_TIMEOUT_MS)
+    {
+        sleep_ms(1);
+        waited++;
+    }
+    if ((size_t)st.st_size != size)
+    {
+        close(fd);
+        *retry = true;
+        return false;
+    }
+
+    unsigned char* base = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return false;
+
+    const ModelStoreHeader* header = (const ModelStoreHeader*)base;
+    while (atomic_load_explicit(&header->state, memory_order_acquire) != MODEL_STORE_READY &&
+           waited < MODEL_STORE_ATTACH_TIMEOUT_MS)
+    {
+        sleep_ms(1);
+        waited++;
+    }
+    if (atomic_load_explicit(&header->state, memory_order_acquire) != MODEL_STORE_READY ||
+        !validate_store(base, size, fingerprint))
+    {
+        munmap(base, size);
+        *retry = true;
+        return false;
+    }
+
+    store.base = base;
+    store.size = size;
+    track_alloc(MEM_AI, MEM_HEAP, size);
+    TraceLog(LOG_INFO, "Attached to shared model store %s", name);
+    return true;
+}
+#endif
+
+/**
+ * @brief Attaches to the host's model store, building it if no instance has yet
+ */
+static void attach_model_store(void)
+{
+    if (store.attached) return;
+    store.attached = true;
+
+#ifdef _WIN32
+    TraceLog(LOG_INFO, "Shared model store not supported, using private models");
+#else
+    const uint64_t fingerprint = model_fingerprint();
+    char name[MODEL_STORE_NAME_LEN];
+    snprintf(name, sizeof(name), "/tic_tac_toe_models_u%u_v%d_%016llx", (unsigned int)geteuid(),
+             MODEL_STORE_VERSION, (unsigned long long)fingerprint);
+
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        if (build_store(name, fingerprint)) return;
+
+        bool retry = false;
+        if (open_store(name, fingerprint, &retry)) return;
+        if (!retry) break;
+
+        // Left by a builder that crashed, or removed in between, replace it once
+        TraceLog(LOG_WARNING, "Shared model store %s is unusable, rebuilding it", name);
+        shm_unlink(name);
+    }
+    TraceLog(LOG_WARNING, "Shared model store unavailable, using private models");
+#endif
+}
+
+static const void* shared_section(const ModelSectionId id)
+{
+    attach_model_store();
+    if (!store.base) return NULL;
+
+    const ModelSection* section = &((const ModelStoreHeader*)store.base)->sections[id];
+    return section->offset != 0 ? store.base + section->offset : NULL;
+}
+
+/**
+ * @brief Returns the neural network from the shared store
+ *
+ * @return Read-only model, NULL if there is no usable store or the model failed to load
+ *
+ * @details Main thread only. The first call attaches to or builds the store.
+ */
+const NeuralNetwork* shared_neural_network(void)
+{
+    return shared_section(MODEL_SECTION_NEURAL_NETWORK);
+}
+
+/**
+ * @brief Returns the naive Bayes model from the shared store, see shared_neural_network()
+ */
+const BayesModel* shared_bayes_model(void)
+{
+    return shared_section(MODEL_SECTION_BAYES);
+}
+
+/**
+ * @brief Unmaps the store, the shared object itself stays for other instances
+ *
+ * @details Stop every thread using the shared models first
+ */
+void detach_model_store(void)
+{
+#ifndef _WIN32
+    if (store.base)
+    {
+        track_free(MEM_AI, MEM_HEAP, store.size);
+        munmap(store.base, store.size);
+    }
+#endif
+    memset(&store, 0, sizeof(store));
+}
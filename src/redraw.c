@@ -0,0 +1,141 @@
+/**
+ * @file redraw.c
+ * @brief Event-driven redraw, skips frames when nothing on screen can have changed
+ *
+ * The last presented frame stays on screen while the loop sleeps for an idle tick
+ * and polls input, the audio thread keeps the music playing meanwhile. A frame is
+ * drawn again on input, resize, a change of game state, an animation in progress or
+ * a finished AI move.
+ */
+#include <redraw.h>
+#include <ai_worker.h>
+#include <ui_tree.h>
+#include <update.h>
+
+/**
+ * @brief Checks if the current screen is animating and must be drawn every frame
+ */
+static bool is_animating(const GameContext* context)
+{
+    if (ai_worker_busy(context->ai_worker)) return true; // Thinking indicator
+    if (context->memory_stats_enabled) return true;      // Counters change from other threads
+
+    switch (context->state)
+    {
+    case GAME_STATE_PLAYING:
+        return !context->start_screen_shown;
+    case GAME_STATE_SPECTATOR:
+        // Boards are updated by the spectator workers
+        return true;
+    case GAME_STATE_P1_WIN:
+    case GAME_STATE_P2_WIN:
+    case GAME_STATE_DRAW:
+        // Game over popup appears one second after the winning move
+        return !context->transition.active || context->transition.elapsed < TRANSITION_SECONDS;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Initializes a tracker so the first frame is always drawn
+ *
+ * @param tracker Pointer to the RedrawTracker
+ */
+void init_redraw_tracker(RedrawTracker* tracker)
+{
+    *tracker = (RedrawTracker){0};
+    tracker->animating = true;
+    tracker->report_since = GetTime();
+    tracker->cpu_since = clock();
+}
+
+/**
+ * @brief Decides whether the current frame has to be drawn
+ *
+ * @param tracker Pointer to the RedrawTracker
+ * @param context Pointer to the current game context
+ * @param resized true if the window was resized this frame
+ * @return true if anything visible may have changed since the last drawn frame
+ */
+bool frame_needs_redraw(const RedrawTracker* tracker, const GameContext* context, const bool resized)
+{
+    if (resized || tracker->animating || is_animating(context)) return true;
+
+    // Input, mouse movement only matters when it changed the hovered button
+    if (ui_tree_dirty() || GetMouseWheelMove() != 0) return true;
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) return true;
+    if (GetKeyPressed() != 0) return true;
+
+    // State changed without input, e.g. a finished AI move
+    if (tracker->state != context->state || tracker->x_board != x_board || tracker->o_board != o_board ||
+        tracker->audio_disabled != context->audio_disabled ||
+        tracker->start_screen_shown != context->start_screen_shown ||
+        tracker->search_stats_enabled != context->search_stats_enabled)
+    {
+        return true;
+    }
+
+    // Repaint now and then in case the window contents were damaged
+    return GetTime() - tracker->last_draw_time >= FORCED_REDRAW_SECONDS;
+}
+
+/**
+ * @brief Records what the frame just drawn showed
+ *
+ * @param tracker Pointer to the RedrawTracker
+ * @param context Pointer to the current game context
+ */
+void note_frame_drawn(RedrawTracker* tracker, const GameContext* context)
+{
+    tracker->state = context->state;
+    tracker->x_board = x_board;
+    tracker->o_board = o_board;
+    tracker->audio_disabled = context->audio_disabled;
+    tracker->start_screen_shown = context->start_screen_shown;
+    tracker->search_stats_enabled = context->search_stats_enabled;
+    clear_ui_tree_dirty();
+    // One trailing frame after an animation ends so its final state is shown
+    tracker->animating = is_animating(context);
+    tracker->last_draw_time = GetTime();
+    tracker->frames_drawn++;
+}
+
+/**
+ * @brief Sleeps for one idle tick and polls input in place of EndDrawing()
+ *
+ * @param tracker Pointer to the RedrawTracker
+ */
+void wait_idle_tick(RedrawTracker* tracker)
+{
+    WaitTime(IDLE_TICK_SECONDS);
+    PollInputEvents();
+    tracker->idle_ticks++;
+}
+
+/**
+ * @brief Logs frames drawn, idle ticks and process CPU use every UTILISATION_REPORT_SECONDS
+ *
+ * @param tracker Pointer to the RedrawTracker
+ * @param event_driven true if event-driven redraw is enabled, for the log line
+ *
+ * @note CPU time is for the whole process, including the audio and AI threads
+ */
+void report_render_utilisation(RedrawTracker* tracker, const bool event_driven)
+{
+    const double now = GetTime();
+    const double elapsed = now - tracker->report_since;
+    if (elapsed < UTILISATION_REPORT_SECONDS) return;
+
+    const clock_t cpu_now = clock();
+    const double cpu_seconds = (double)(cpu_now - tracker->cpu_since) / CLOCKS_PER_SEC;
+
+    TraceLog(LOG_INFO, "Render (%s): %.1f frames/s drawn, %.1f idle ticks/s, CPU %.1f%%",
+             event_driven ? "event-driven" : "continuous", tracker->frames_drawn / elapsed,
+             tracker->idle_ticks / elapsed, cpu_seconds / elapsed * 100.0);
+
+    tracker->report_since = now;
+    tracker->cpu_since = cpu_now;
+    tracker->frames_drawn = 0;
+    tracker->idle_ticks = 0;
+}
@@ -1,40 +1,133 @@
 #include "render.h"
+#include <ai_worker.h>
+#include <arena.h>
+#include <atlas.h>
+#include <button_mesh.h>
 #include <buttons.h>
 #include <computer.h>
+#include <mem_stats.h>
+#include <memo.h>
 
 #include <raylib.h>
+#include <resource_manager.h>
+#include <string.h>
+#include <ui_text.h>
+#include <update.h>
 #include <utils.h>
 
+/**
+ * Static screen content (background, grid lines, titles, images) is rendered once into
+ * a texture per screen and composited with a single textured quad. A layer is rebuilt
+ * when the layout generation or its content key (e.g. the selected game mode) changes.
+ */
+typedef enum {
+    LAYER_GRID,
+    LAYER_MENU,
+    LAYER_INSTRUCTIONS,
+    LAYER_COUNT
+} ScreenLayer;
+
+typedef struct {
+    RenderTexture2D target;
+    uint32_t layout_generation;
+    int content_key;
+    bool valid;
+} LayerCache;
+
+static LayerCache layers[LAYER_COUNT] = {0};
+
+/**
+ * @brief Checks whether a layer has to be redrawn, (re)allocating its texture when needed
+ * @param layer Layer to check
+ * @param content_key Value identifying the non-layout state the layer depends on
+ * @param layout_generation Current layout generation
+ * @return true if the caller has to redraw the layer's static content
+ */
+static bool layer_is_stale(const ScreenLayer layer, const int content_key, const uint32_t layout_generation)
+{
+    LayerCache* cache = &layers[layer];
+    const int screen_width = GetScreenWidth();
+    const int screen_height = GetScreenHeight();
+
+    if (cache->valid && cache->layout_generation == layout_generation && cache->content_key == content_key)
+    {
+        return false;
+    }
+
+    if (cache->target.id == 0 || cache->target.texture.width != screen_width ||
+        cache->target.texture.height != screen_height)
+    {
+        if (cache->target.id != 0)
+        {
+            track_free(MEM_UI, MEM_GPU, render_texture_bytes(cache->target));
+            UnloadRenderTexture(cache->target);
+        }
+        cache->target = LoadRenderTexture(screen_width, screen_height);
+        if (cache->target.id == 0)
+        {
+            TraceLog(LOG_WARNING, "Failed to allocate render layer %d", layer);
+        }
+        track_alloc(MEM_UI, MEM_GPU, render_texture_bytes(cache->target));
+    }
+
+    cache->layout_generation = layout_generation;
+    cache->content_key = content_key;
+    cache->valid = cache->target.id != 0;
+    return true;
+}
+
+/**
+ * @brief Composites a layer onto the screen with one textured quad
+ * @param layer Layer to draw
+ */
+static void draw_layer(const ScreenLayer layer)
+{
+    const Texture2D texture = layers[layer].target.texture;
+
+    // Render textures are stored upside down
+    DrawTextureRec(texture, (Rectangle){0, 0, (float)texture.width, -(float)texture.height}, (Vector2){0, 0},
+                   WHITE);
+}
+
+/**
+ * @brief Releases the GPU memory held by the layer cache
+ * @details Must be called before the window is closed
+ */
+void unload_render_layers(void)
+{
+    for (int i = 0; i < LAYER_COUNT; i++)
+    {
+        if (layers[i].target.id != 0)
+        {
+            track_free(MEM_UI, MEM_GPU, render_texture_bytes(layers[i].target));
+            UnloadRenderTexture(layers[i].target);
+        }
+        layers[i] = (LayerCache){0};
+    }
+}
+
 /**
  * @brief Renders buttons onto the window
  * @param buttons Pointer to Button array
  * @param button_count size of the Button array passed to function
- * @param buttons_per_row number of buttons on a row
  * @param render_opts Pointer to UiOptions
  * @param cache Pointer to a MemoCache
- * @param need_recalc boolean to indicate whether cached Rectangles need to be recalculated
+ * @details Buttons are laid out by the UI tree, hover is resolved there when the mouse moves
  */
-static void render_buttons(Button* buttons, const size_t button_count, const int buttons_per_row,
-                           const UiOptions* render_opts, MemoCache* cache, const bool need_recalc)
+static void render_buttons(const Button* buttons, const size_t button_count, const UiOptions* render_opts,
+                           MemoCache* cache)
 {
-    const int screen_width = GetScreenWidth();
-    const int screen_height = GetScreenHeight();
+    const ButtonGeometry* geometries[MAX_BUTTON_GROUP_SIZE];
+    Color fill_colors[MAX_BUTTON_GROUP_SIZE];
+    size_t drawable = 0;
 
-    for (int i = 0; i < button_count; i++)
+    for (int i = 0; i < button_count && i < MAX_BUTTON_GROUP_SIZE; i++)
     {
-        if (buttons[i].rect == NULL || need_recalc)
-        {
-            if (buttons[i].rect == NULL)
-            {
-                buttons[i].rect = (Rectangle*)malloc(sizeof(Rectangle));
-            }
-            *buttons[i].rect = calculate_button_rectangle(buttons[i].width, buttons[i].padding, buttons[i].height,
-                                                          buttons[i].first_render_offset, i, buttons_per_row,
-                                                          screen_height, screen_width);
-        }
+        // Not laid out yet
+        if (buttons[i].geometry == NULL) continue;
+
         const bool overwrite_default_colors = buttons[i].override_default_colors;
-        const bool is_hovering = CheckCollisionPointRec(GetMousePosition(), *buttons[i].rect);
-        const Color buttonColor = is_hovering
+        const Color buttonColor = buttons[i].hovered
                                       ? (overwrite_default_colors
                                              ? buttons[i].clickColor
                                              : render_opts->btn_clicked_color)
@@ -42,52 +135,44 @@ static void render_buttons(Button* buttons, const size_t button_count, const int
                                       ? buttons[i].color
                                       : render_opts->primary_btn_color;
 
+        geometries[drawable] = buttons[i].geometry;
+        fill_colors[drawable] = buttonColor;
+        drawable++;
+    }
 
-        // Draw button
-        if (buttons[i].rounded)
-        {
-            DrawRectangleRounded(*buttons[i].rect, 0.3f, 20, buttonColor);
-            DrawRectangleRoundedLines(*buttons[i].rect, 0.3f, 20, 2.0f, GRAY);
-        }
-        else
-        {
-            DrawRectangleRounded(*buttons[i].rect, 0, 20, buttonColor);
-            DrawRectangleRoundedLines(*buttons[i].rect, 0, 20, 2.0f, GRAY);
-        }
+    // Draw every button of the group in one batch, hover only changes the fill color
+    draw_button_geometry(geometries, fill_colors, drawable, GRAY);
+
+    for (int i = 0; i < button_count; i++)
+    {
+        if (buttons[i].rect == NULL) continue;
 
         // Center text
         const Coords cords =
             calculate_centered_text_xy(buttons[i].text, buttons[i].font_size, buttons[i].rect->x, buttons[i].rect->y,
-                                       buttons[i].rect->width, buttons[i].rect->height);
+                                       buttons[i].rect->width, buttons[i].rect->height, cache);
 
-        DrawText(buttons[i].text, (int)cords.x, (int)cords.y, buttons[i].font_size, BLACK);
+        draw_ui_text(buttons[i].text, (int)cords.x, (int)cords.y, buttons[i].font_size, BLACK);
     }
 }
 
 /**
- * @brief Function for game start transition
+ * @brief Renders the game start transition
  * @param resources Pointer to the GameResources
  * @param render_opts Pointer to the UiOptions
  * @param context Pointer to the current game context
- * @details Manage how the game transitions at the start of game.
- * Display message showing which player begins first
+ * @details Display message showing which player begins first, the transition
+ * itself is advanced by the update phase
  *
  */
-void do_game_start_transition(const GameResources* resources, const UiOptions* render_opts, GameContext* context)
+void render_game_start_transition(const GameResources* resources, const UiOptions* render_opts,
+                                  const GameContext* context)
 {
     const int screen_width = GetScreenWidth();
     const int screen_height = GetScreenHeight();
 
-    if (!context->transition.active)
-    {
-        context->transition.start_time = GetTime();
-        context->transition.active = true;
-    }
-
     render_grid(resources, render_opts, context, false);
 
-    const double elapsed_time = GetTime() - context->transition.start_time;
-
     // Semi-transparent background
     DrawRectangle(0, 0, screen_width, screen_height, (Color){0, 0, 0, 100});
 
@@ -101,22 +186,105 @@ void do_game_start_transition(const GameResources* resources, const UiOptions* r
 
     // Calculate centered text position
     const Coords text_coords =
-        calculate_centered_text_xy(start_msg, 40, 0, 0, (float)screen_width, (float)screen_height);
+        calculate_centered_text_xy(start_msg, 40, 0, 0, (float)screen_width, (float)screen_height,
+                                   context->memo_cache);
+
+    draw_ui_text(start_msg, (int)text_coords.x, (int)text_coords.y, 40, RAYWHITE);
+}
+
+/**
+ * @brief Renders the loading screen shown while assets are decoded
+ * @param progress Share of the assets loaded, 0.0 - 1.0
+ * @param render_opts Pointer to the UiOptions
+ */
+void render_loading_screen(const float progress, const UiOptions* render_opts)
+{
+    static const char TITLE[] = "TIC-TAC-TOE";
+    static const int FONT_SIZE = 70;
 
-    DrawText(start_msg, (int)text_coords.x, (int)text_coords.y, 40, RAYWHITE);
+    const int screen_width = GetScreenWidth();
+    const int screen_height = GetScreenHeight();
+
+    ClearBackground(render_opts->background_color);
+
+    const Coords title_c =
+        calculate_centered_text_xy(TITLE, FONT_SIZE, 0, 0, (float)screen_width, (float)screen_height / 2, NULL);
+    draw_ui_text(TITLE, (int)title_c.x, (int)title_c.y, FONT_SIZE, DARKPURPLE);
 
-    // Reset transition after 1 second
-    if (elapsed_time >= 1.0)
+    // Progress bar
+    const Rectangle bar = {
+        (float)screen_width * 0.2f, (float)screen_height * 0.55f, (float)screen_width * 0.6f, 24
+    };
+    DrawRectangleRec(bar, LIGHTGRAY);
+    DrawRectangleRec((Rectangle){bar.x, bar.y, bar.width * progress, bar.height}, render_opts->primary_btn_color);
+    DrawRectangleLinesEx(bar, 2, GRAY);
+}
+
+/**
+ * @brief Renders the statistics of the computer's last search
+ * @param context Pointer to the current game context
+ * @details Shown in the bottom left corner while search statistics are enabled (F3)
+ */
+static void render_search_stats(const GameContext* context)
+{
+    const SearchStats* stats = &context->last_search_stats;
+    const int font_size = 18;
+    const int x = 10;
+    const int y = GetScreenHeight() - 5 * (font_size + 4) - 10;
+
+    DrawRectangle(x - 5, y - 5, 420, 5 * (font_size + 4) + 10, (Color){255, 255, 255, 200});
+    draw_ui_text("Search statistics (F3)", x, y, font_size, DARKPURPLE);
+    draw_ui_text(arena_printf(&frame_arena, MEM_UI, "Nodes: %llu  Leaves: %llu  TT hits: %llu",
+                              (unsigned long long)stats->nodes, (unsigned long long)stats->leaf_evals,
+                              (unsigned long long)stats->tt_hits),
+                 x, y + (font_size + 4), font_size, BLACK);
+    draw_ui_text(arena_printf(&frame_arena, MEM_UI, "Cutoffs: %llu  Depth: %d  EBF: %.2f",
+                              (unsigned long long)stats->cutoffs, stats->max_ply, stats->effective_branching),
+                 x, y + 2 * (font_size + 4), font_size, BLACK);
+    draw_ui_text(arena_printf(&frame_arena, MEM_UI, "Cutoffs by move: %llu %llu %llu %llu %llu %llu %llu %llu %llu",
+                              (unsigned long long)stats->cutoffs_by_move[0],
+                              (unsigned long long)stats->cutoffs_by_move[1],
+                              (unsigned long long)stats->cutoffs_by_move[2],
+                              (unsigned long long)stats->cutoffs_by_move[3],
+                              (unsigned long long)stats->cutoffs_by_move[4],
+                              (unsigned long long)stats->cutoffs_by_move[5],
+                              (unsigned long long)stats->cutoffs_by_move[6],
+                              (unsigned long long)stats->cutoffs_by_move[7],
+                              (unsigned long long)stats->cutoffs_by_move[8]),
+                 x, y + 3 * (font_size + 4), font_size, BLACK);
+    draw_ui_text(arena_printf(&frame_arena, MEM_UI, "Wall time: %.3f ms", stats->wall_time * 1000.0), x,
+                 y + 4 * (font_size + 4), font_size, BLACK);
+}
+
+/**
+ * @brief Renders the memory held by every subsystem
+ * @details Shown in the top left corner of every screen while enabled (F4), in KiB
+ */
+void render_memory_stats(void)
+{
+    const int font_size = 16;
+    const int line_height = font_size + 4;
+    const int x = 10;
+    const int y = 10;
+
+    DrawRectangle(x - 5, y - 5, 470, (MEM_SUBSYSTEM_COUNT + 2) * line_height + 10, (Color){255, 255, 255, 200});
+    draw_ui_text("Memory KiB, now / peak / total (F4)", x, y, font_size, DARKPURPLE);
+
+    size_t gpu_now = 0;
+    size_t gpu_peak = 0;
+    for (int i = 0; i < MEM_SUBSYSTEM_COUNT; i++)
     {
-        context->transition.active = false;
-        context->start_screen_shown = true;
-        if (current_player == get_computer_player(context) && context->computer_enabled)
-        {
-            computer_move(context, resources->models);
-            PlaySound(resources->fx_symbol);
-            current_player = get_computer_player(context) == PLAYER_X ? PLAYER_O : PLAYER_X;
-        }
+        const MemCounter heap = get_mem_counter(i, MEM_HEAP);
+        const MemCounter gpu = get_mem_counter(i, MEM_GPU);
+        gpu_now += gpu.current;
+        gpu_peak += gpu.peak;
+        draw_ui_text(arena_printf(&frame_arena, MEM_UI, "%-7s %8zu / %8zu / %10llu  GPU %zu", mem_subsystem_name(i),
+                                  heap.current / 1024, heap.peak / 1024, (unsigned long long)(heap.total / 1024),
+                                  gpu.current / 1024),
+                     x, y + (i + 1) * line_height, font_size, BLACK);
     }
+    draw_ui_text(arena_printf(&frame_arena, MEM_UI, "GPU textures %zu / %zu", gpu_now / 1024, gpu_peak / 1024), x,
+                 y + (MEM_SUBSYSTEM_COUNT + 1) * line_height, font_size, BLACK);
 }
 
 /**
@@ -140,18 +308,11 @@ const char* get_game_mode_name(const GameMode* mode) {
 }
 
 /**
- * @brief Renders the game grid, game mode, current player symbols, and optional UI elements
- * @param resources Pointer to the GameResources
+ * @brief Draws the static part of the game screen, grid lines and game mode label
  * @param render_opts Pointer to the UiOptions
  * @param context Pointer to the current game context
- * @param show_buttons boolean to indicate if buttons should be rendered or not
- * @details This function renders the game grid with player symbols
- * - Render music toggle button.
- * - If the boolean show_buttons is true, renders return to menu button.
- * - Draw winning grid lines if there is a winner
  */
-void render_grid(const GameResources* resources, const UiOptions* render_opts, const GameContext* context,
-                 const bool show_buttons)
+static void draw_grid_layer(const UiOptions* render_opts, const GameContext* context)
 {
     ClearBackground(render_opts->background_color);
 
@@ -182,21 +343,46 @@ void render_grid(const GameResources* resources, const UiOptions* render_opts, c
         (float)grid->start_x,
         (float)grid->start_y - 160,
         grid->grid_size,
-        30
+        30,
+        context->memo_cache
     );
 
-    DrawText(game_mode, (int)text_coords.x, (int)text_coords.y, 30, DARKGRAY);
+    draw_ui_text(game_mode, (int)text_coords.x, (int)text_coords.y, 30, DARKGRAY);
+}
+
+/**
+ * @brief Renders the game grid, game mode, current player symbols, and optional UI elements
+ * @param resources Pointer to the GameResources
+ * @param render_opts Pointer to the UiOptions
+ * @param context Pointer to the current game context
+ * @param show_buttons boolean to indicate if buttons should be rendered or not
+ * @details This function renders the game grid with player symbols
+ * - Render music toggle button.
+ * - If the boolean show_buttons is true, renders return to menu button.
+ * - Draw winning grid lines if there is a winner
+ */
+void render_grid(const GameResources* resources, const UiOptions* render_opts, const GameContext* context,
+                 const bool show_buttons)
+{
+    if (layer_is_stale(LAYER_GRID, (int)context->selected_game_mode, context->layout.generation))
+    {
+        BeginTextureMode(layers[LAYER_GRID].target);
+        draw_grid_layer(render_opts, context);
+        EndTextureMode();
+    }
+    draw_layer(LAYER_GRID);
+
+    const GridDimensions* grid = &context->grid;
     const int symbol_size = grid->cell_size / 2;
 
     const Rectangle audio_ico_rect = calc_music_icon_rect(context, resources);
 
     // Music toggle icon
-    const Texture2D music_icon = context->audio_disabled ? resources->music_off : resources->music_on;
+    const SpriteId music_icon = context->audio_disabled ? SPRITE_MUSIC_OFF : SPRITE_MUSIC_ON;
 
-    const float icon_scale = 0.08f;
     const Vector2 icon_pos = {audio_ico_rect.x, audio_ico_rect.y};
 
-    DrawTextureEx(music_icon, icon_pos, 0.0f, icon_scale, WHITE);
+    draw_sprite(&resources->atlas, music_icon, icon_pos, 1.0f, WHITE);
 
     uint16_t mask = 1;
     for (int i = 0; i < BOARD_SIZE * BOARD_SIZE; i++)
@@ -206,23 +392,43 @@ void render_grid(const GameResources* resources, const UiOptions* render_opts, c
         const int draw_x = grid->start_x + col * grid->cell_size + (grid->cell_size - symbol_size) / 2;
         const int draw_y = grid->start_y + row * grid->cell_size + (grid->cell_size - symbol_size) / 2;
 
+        const Rectangle symbol_rect = {(float)draw_x, (float)draw_y, (float)symbol_size, (float)symbol_size};
+
         if (x_board & mask)
         {
-            DrawText("X", draw_x, draw_y, symbol_size, BLUE);
+            draw_x_symbol(symbol_rect, BLUE);
         }
         else if (o_board & mask)
         {
-            DrawText("O", draw_x, draw_y, symbol_size, RED);
+            draw_o_symbol(symbol_rect, RED);
         }
         mask <<= 1;
     }
 
+    // Thinking indicator while the AI worker searches
+    if (ai_worker_busy(context->ai_worker))
+    {
+        static const char THINKING_MSG[] = "Computer is thinking...";
+        const int dots = (int)(GetTime() * 3.0) % 4;
+        const Coords thinking_coords = calculate_centered_text_xy(
+            THINKING_MSG, 24, (float)grid->start_x, (float)grid->start_y - 60, grid->grid_size, 24,
+            context->memo_cache);
+        draw_ui_text(arena_printf(&frame_arena, MEM_UI, "%.*s", (int)sizeof(THINKING_MSG) - 4 + dots, THINKING_MSG),
+                     (int)thinking_coords.x, (int)thinking_coords.y, 24, DARKGRAY);
+    }
+
     if (show_buttons)
     {
-        render_buttons(IN_GAME_BUTTONS, 1, 1, render_opts, context->memo_cache, context->needs_recalculation);
+        render_buttons(IN_GAME_BUTTONS, 1, render_opts, context->memo_cache);
     }
 
     display_score(context);
+
+    if (context->search_stats_enabled && context->computer_enabled)
+    {
+        render_search_stats(context);
+    }
+
     if (context->state == GAME_STATE_P1_WIN || context->state == GAME_STATE_P2_WIN)
     {
         const int winning_pattern = check_win(current_player);
@@ -291,12 +497,11 @@ void render_grid(const GameResources* resources, const UiOptions* render_opts, c
 }
 
 /**
- * @brief Renders main menu of the game
+ * @brief Draws the static part of the main menu, title and menu image
  * @param resources Pointer to the GameResources
  * @param render_opts Pointer to the UiOptions
- * @param context Pointer to the current game context
  */
-void render_menu(const GameResources* resources, const UiOptions* render_opts, const GameContext* context)
+static void draw_menu_layer(const GameResources* resources, const UiOptions* render_opts)
 {
     const int screen_width = GetScreenWidth();
     const int screen_height = GetScreenHeight();
@@ -309,35 +514,57 @@ void render_menu(const GameResources* resources, const UiOptions* render_opts, c
 
     // Title rendering
     const Coords title_c =
-        calculate_centered_text_xy(TITLE, FONT_SIZE, 0, 0, (float)screen_width, (float)FONT_SIZE);
-    DrawText(TITLE, (int)title_c.x, (int)title_c.y, FONT_SIZE, DARKPURPLE);
-
-    const float image_scale = 0.3f;
-    const float scaled_width = (float)resources->main_menu_img.width * image_scale;
-    const float scaled_height = (float)resources->main_menu_img.height * image_scale;
-    const Vector2 image_pos = {
-        ((float)screen_width - scaled_width) / 2,
-        ((float)screen_height - scaled_height) / 4
+        calculate_centered_text_xy(TITLE, FONT_SIZE, 0, 0, (float)screen_width, (float)FONT_SIZE, NULL);
+    draw_ui_text(TITLE, (int)title_c.x, (int)title_c.y, FONT_SIZE, DARKPURPLE);
+
+    // MENU_IMAGE_SCALE of the window, drawn 1:1 except while a resize is settling
+    const Vector2 image_size = sprite_draw_size(&resources->atlas, SPRITE_MAIN_MENU, screen_width, screen_height);
+    const Rectangle image_rect = {
+        (float)(int)(((float)screen_width - image_size.x) / 2),
+        (float)(int)(((float)screen_height - image_size.y) / 4),
+        image_size.x, image_size.y
     };
 
-    DrawTextureEx(resources->main_menu_img, image_pos, 0.0f, image_scale, WHITE);
+    draw_sprite_sized(&resources->atlas, SPRITE_MAIN_MENU, image_rect, WHITE);
+}
+
+/**
+ * @brief Renders main menu of the game
+ * @param resources Pointer to the GameResources
+ * @param render_opts Pointer to the UiOptions
+ * @param context Pointer to the current game context
+ */
+void render_menu(const GameResources* resources, const UiOptions* render_opts, const GameContext* context)
+{
+    if (layer_is_stale(LAYER_MENU, 0, context->layout.generation))
+    {
+        BeginTextureMode(layers[LAYER_MENU].target);
+        draw_menu_layer(resources, render_opts);
+        EndTextureMode();
+    }
+    draw_layer(LAYER_MENU);
 
     const size_t button_count = sizeof(MAIN_MENU_BUTTONS) / sizeof(Button);
 
-    render_buttons(MAIN_MENU_BUTTONS, button_count, 2, render_opts, context->memo_cache,
-                   context->needs_recalculation);
+    render_buttons(MAIN_MENU_BUTTONS, button_count, render_opts, context->memo_cache);
 
     const Rectangle audio_ico_rect = calc_music_icon_rect(context, resources);
 
     // Music toggle icon
-    const Texture2D music_icon = context->audio_disabled ? resources->music_off : resources->music_on;
+    const SpriteId music_icon = context->audio_disabled ? SPRITE_MUSIC_OFF : SPRITE_MUSIC_ON;
 
-    const float icon_scale = 0.08f;
     const Vector2 icon_pos = {audio_ico_rect.x, audio_ico_rect.y};
 
-    DrawTextureEx(music_icon, icon_pos, 0.0f, icon_scale, WHITE);
+    draw_sprite(&resources->atlas, music_icon, icon_pos, 1.0f, WHITE);
 }
 
+typedef struct {
+    Vector2 icon_size;
+    int screen_width;
+} MusicIconKey;
+
+DEFINE_MEMO(music_icon_rect, MusicIconKey, Rectangle, MEMO_FUNCTION_CAPACITY)
+
 /**
  * @brief Calculates dimensions and position of music toggle icon.
  * @param resources Pointer to the GameResources
@@ -349,14 +576,23 @@ void render_menu(const GameResources* resources, const UiOptions* render_opts, c
  */
 Rectangle calc_music_icon_rect(const GameContext* context, const GameResources* resources)
 {
-    const Texture2D music_icon = context->audio_disabled ? resources->music_off : resources->music_on;
+    const Vector2 music_icon = sprite_size(&resources->atlas,
+                                           context->audio_disabled ? SPRITE_MUSIC_OFF : SPRITE_MUSIC_ON);
 
-    const float icon_scale = 0.08f;
-    const Vector2 icon_pos = {(float)GetScreenWidth() - (float)music_icon.width * icon_scale - 20, 940};
+    MusicIconKey key;
+    memset(&key, 0, sizeof(MusicIconKey));
+    key.icon_size = music_icon;
+    key.screen_width = GetScreenWidth();
 
-    return (Rectangle){
-        icon_pos.x, icon_pos.y, (float)music_icon.width * icon_scale, (float)music_icon.height * icon_scale
-    };
+    Rectangle rect;
+    if (music_icon_rect_memo_get(&key, &rect)) return rect;
+
+    // Icons are resampled to MUSIC_ICON_SCALE at load time
+    const Vector2 icon_pos = {(float)key.screen_width - music_icon.x - 20, 940};
+
+    rect = (Rectangle){icon_pos.x, icon_pos.y, music_icon.x, music_icon.y};
+    music_icon_rect_memo_put(&key, &rect);
+    return rect;
 }
 
 /**
@@ -385,9 +621,8 @@ void render_game_over(const GameContext* context, const UiOptions* render_opts)
     DrawRectangle(0, 0, screen_width, screen_height, (Color){0, 0, 0, 200});
 
 
-    // Calculate message box dimensions
-    const BoxDimensions box = calculate_centered_box_dimensions(0.5f, 0.4f, screen_height, screen_width,
-                                                                context->memo_cache);
+    // Message box dimensions, laid out once per resize
+    const BoxDimensions box = context->layout.game_over_box;
 
     // Draw message box
     DrawRectangle((int)box.x, (int)box.y, (int)box.width, (int)box.height, DARKGRAY);
@@ -423,18 +658,16 @@ void render_game_over(const GameContext* context, const UiOptions* render_opts)
                                                    context->memo_cache);
 
 
-    DrawText(message, (int)text_c.x, (int)text_c.y, 40, RAYWHITE);
+    draw_ui_text(message, (int)text_c.x, (int)text_c.y, 40, RAYWHITE);
     const size_t button_count = sizeof(GAME_OVER_BUTTONS) / sizeof(Button);
-    render_buttons(GAME_OVER_BUTTONS, button_count, 1, render_opts, context->memo_cache, context->needs_recalculation);
+    render_buttons(GAME_OVER_BUTTONS, button_count, render_opts, context->memo_cache);
 }
 
 /**
- * @brief Renders the instructions page
- * @param resources Pointer to the GameResources
+ * @brief Draws the static part of the instructions page, title, text and images
  * @param render_opts Pointer to the UiOptions
- * @param context Pointer to the current game context
  */
-void render_instructions(const GameResources* resources, const UiOptions* render_opts, const GameContext* context)
+static void draw_instructions_layer(const UiOptions* render_opts)
 {
     const int screen_width = GetScreenWidth();
     const int screen_height = GetScreenHeight();
@@ -450,22 +683,41 @@ void render_instructions(const GameResources* resources, const UiOptions* render
 
     // Title rendering
     const Coords title_c =
-        calculate_centered_text_xy(TITLE, FONT_SIZE, 0, 0, (float)screen_width, (float)FONT_SIZE);
-    DrawText(TITLE, (int)title_c.x, (int)title_c.y, FONT_SIZE, DARKPURPLE);
+        calculate_centered_text_xy(TITLE, FONT_SIZE, 0, 0, (float)screen_width, (float)FONT_SIZE, NULL);
+    draw_ui_text(TITLE, (int)title_c.x, (int)title_c.y, FONT_SIZE, DARKPURPLE);
 
     // Instructions render
     for (int i = 0; i < 4; i++)
     {
-        DrawText(INSTRUCTION_TEXTS[i], 30, 120 + i * 60, 39, BLACK);
+        draw_ui_text(INSTRUCTION_TEXTS[i], 30, 120 + i * 60, 39, BLACK);
     }
 
     const int instructions_x = (int)((float)screen_width / 2 * 0.3f);
 
-    // Render instruction image
-    DrawTexture(resources->instructions_1, instructions_x, (int)((float)screen_height / 2 * 0.7f), WHITE);
-    DrawTexture(resources->instructions_2, instructions_x, (int)((float)screen_height / 2 * 1.08f), WHITE);
+    // Render instruction images, loaded on first use and only needed while the layer is redrawn
+    DrawTexture(get_texture_resource(RES_INSTRUCTIONS_1),
+                instructions_x, (int)((float)screen_height / 2 * 0.7f), WHITE);
+    DrawTexture(get_texture_resource(RES_INSTRUCTIONS_2),
+                instructions_x, (int)((float)screen_height / 2 * 1.08f), WHITE);
+}
 
-    render_buttons(INSTRUCTIONS_BUTTONS, 1, 1, render_opts, context->memo_cache, context->needs_recalculation);
+/**
+ * @brief Renders the instructions page
+ * @param resources Pointer to the GameResources
+ * @param render_opts Pointer to the UiOptions
+ * @param context Pointer to the current game context
+ */
+void render_instructions(const GameResources* resources, const UiOptions* render_opts, const GameContext* context)
+{
+    if (layer_is_stale(LAYER_INSTRUCTIONS, 0, context->layout.generation))
+    {
+        BeginTextureMode(layers[LAYER_INSTRUCTIONS].target);
+        draw_instructions_layer(render_opts);
+        EndTextureMode();
+    }
+    draw_layer(LAYER_INSTRUCTIONS);
+
+    render_buttons(INSTRUCTIONS_BUTTONS, 1, render_opts, context->memo_cache);
 }
 
 /**
@@ -475,11 +727,8 @@ void render_instructions(const GameResources* resources, const UiOptions* render
  */
 void render_exit(const UiOptions* render_opts, const GameContext* context)
 {
-    const int screen_width = GetScreenWidth();
-    const int screen_height = GetScreenHeight();
-    // Calculate message box dimensions
-    const BoxDimensions box_dim = calculate_centered_box_dimensions(0.5f, 0.3f, screen_height, screen_width,
-                                                                    context->memo_cache);
+    // Message box dimensions, laid out once per resize
+    const BoxDimensions box_dim = context->layout.exit_box;
     // Draw message box
     DrawRectangle((int)box_dim.x, (int)box_dim.y, (int)box_dim.width, (int)box_dim.height, DARKGRAY);
     DrawRectangleLinesEx((Rectangle){box_dim.x, box_dim.y, box_dim.width, box_dim.height}, 4, RAYWHITE);
@@ -487,12 +736,13 @@ void render_exit(const UiOptions* render_opts, const GameContext* context)
     // Draw message
     const char message[] = "Do you want to exit?";
     const Coords text_cords =
-        calculate_centered_text_xy(message, 30, box_dim.x, box_dim.y, box_dim.width, box_dim.height);
+        calculate_centered_text_xy(message, 30, box_dim.x, box_dim.y, box_dim.width, box_dim.height,
+                                   context->memo_cache);
 
-    DrawText(message, (int)text_cords.x, (int)text_cords.y - 115, 30, RAYWHITE);
+    draw_ui_text(message, (int)text_cords.x, (int)text_cords.y - 115, 30, RAYWHITE);
 
     const size_t button_count = sizeof(EXIT_CONFIRMATION_BUTTONS) / sizeof(Button);
-    render_buttons(EXIT_CONFIRMATION_BUTTONS, button_count, 1, render_opts, context->memo_cache, context->needs_recalculation);
+    render_buttons(EXIT_CONFIRMATION_BUTTONS, button_count, render_opts, context->memo_cache);
 }
 
 /**
@@ -504,12 +754,8 @@ void render_exit(const UiOptions* render_opts, const GameContext* context)
  */
 void render_game_mode_choice(const UiOptions* render_opts, const GameContext* context)
 {
-    const int screen_width = GetScreenWidth();
-    const int screen_height = GetScreenHeight();
-
-    // Calculate message box dimensions
-    const BoxDimensions box_dim = calculate_centered_box_dimensions(0.5f, 0.4f, screen_height, screen_width,
-                                                                    context->memo_cache);
+    // Message box dimensions, laid out once per resize
+    const BoxDimensions box_dim = context->layout.mode_choice_box;
 
     // Draw message box
     DrawRectangle((int)box_dim.x, (int)box_dim.y, (int)box_dim.width, (int)box_dim.height, DARKGRAY);
@@ -518,34 +764,28 @@ void render_game_mode_choice(const UiOptions* render_opts, const GameContext* co
     // Draw message
     const char message[] = "Choose game mode!";
     const Coords text_cords =
-        calculate_centered_text_xy(message, 30, box_dim.x, box_dim.y, box_dim.width, box_dim.height);
+        calculate_centered_text_xy(message, 30, box_dim.x, box_dim.y, box_dim.width, box_dim.height,
+                                   context->memo_cache);
 
-    DrawText(message, (int)text_cords.x, (int)text_cords.y - 140, 30, RAYWHITE);
+    draw_ui_text(message, (int)text_cords.x, (int)text_cords.y - 140, 30, RAYWHITE);
 
     const size_t button_count = sizeof(GAME_MODE_BUTTONS) / sizeof(Button);
-    render_buttons(GAME_MODE_BUTTONS, button_count, 1, render_opts, context->memo_cache, context->needs_recalculation);
+    render_buttons(GAME_MODE_BUTTONS, button_count, render_opts, context->memo_cache);
 }
 
 /**
- * @brief function for handling the transition after a win/lose/draw outcome
+ * @brief Renders the final board, followed by the game over popup once the
+ * transition advanced by the update phase has finished
  * @param resources Pointer to the GameResources
  * @param render_opts Pointer to the UiOptions
  * @param context Pointer to the current game context
- * Waits 1 second before the popup message box appears to allow user to see the winning grid
  */
-void do_game_over_transition(const GameResources* resources, const UiOptions* render_opts, GameContext* context)
+void render_game_over_transition(const GameResources* resources, const UiOptions* render_opts,
+                                 const GameContext* context)
 {
-    if (!context->transition.active)
-    {
-        context->transition.start_time = GetTime();
-        context->transition.active = true;
-    }
-
     render_grid(resources, render_opts, context, false);
 
-    const double elapsed_time = GetTime() - context->transition.start_time;
-
-    if (elapsed_time >= 1.0)
+    if (context->transition.active && context->transition.elapsed >= TRANSITION_SECONDS)
     {
         // Semi-transparent background
         DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), (Color){0, 0, 0, 100});
@@ -0,0 +1,299 @@
+/**
+ * @file resource_manager.c
+ * @brief Lazily loaded, reference counted game resources
+ *
+ * Only what the main menu needs is loaded at startup. Everything else is loaded the
+ * first time a state or game mode needs it: set_resource_scope() acquires the
+ * resources of the current state and mode and releases those of the previous one.
+ * Unreferenced resources stay resident as a cache until they no longer fit in the
+ * memory budget, then the least recently used are unloaded.
+ *
+ * Models are shared with the AI worker and spectator threads, which read them
+ * without locking, so once loaded they stay until cleanup. They are a few KB and
+ * mapped from a store shared by every instance on the host when possible, see
+ * model_store.c.
+ * Sound effects are not managed here, the audio thread keeps them decoded.
+ */
+#include <resource_manager.h>
+#include <arena.h>
+#include <loader.h>
+#include <model_store.h>
+#include <neural.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    RESOURCE_TEXTURE,
+    RESOURCE_MODEL
+} ResourceKind;
+
+typedef struct {
+    ResourceKind kind;
+    const char* path;
+    int width;  // Target size for textures, 0 to keep the original size
+    int height;
+} ResourceInfo;
+
+static const ResourceInfo RESOURCE_INFO[RES_COUNT] = {
+    [RES_INSTRUCTIONS_1] = {RESOURCE_TEXTURE, "assets/instructions_1.png", 700, 190},
+    [RES_INSTRUCTIONS_2] = {RESOURCE_TEXTURE, "assets/instructions_2.png", 700, 190},
+    [RES_NEURAL_NETWORK] = {RESOURCE_MODEL, "assets/nn_weights.dat"},
+    [RES_BAYES_MODEL] = {RESOURCE_MODEL, "assets/bayes_model.dat"},
+};
+
+typedef struct {
+    int refs;
+    bool resident;
+    bool failed;        // Not retried every frame after a load error
+    size_t bytes;
+    uint64_t last_used;
+    Texture2D texture;
+} ResourceSlot;
+
+static struct {
+    ResourceSlot slots[RES_COUNT];
+    AiModels models;
+    size_t budget;
+    size_t resident_bytes;
+    uint64_t use_clock;
+    uint32_t scope_mask;
+} manager = {0};
+
+#define RESOURCE_BIT(id) (1u << (id))
+
+/**
+ * @brief Loads a resource into its slot
+ */
+static void load_resource(const ResourceId id)
+{
+    ResourceSlot* slot = &manager.slots[id];
+    const ResourceInfo* info = &RESOURCE_INFO[id];
+
+    switch (info->kind)
+    {
+    case RESOURCE_TEXTURE:
+    {
+        Image image = load_image_asset(info->path);
+        if (image.data == NULL) break;
+        if (info->width > 0 && info->height > 0) ImageResize(&image, info->width, info->height);
+        slot->texture = LoadTextureFromImage(image);
+        slot->bytes = (size_t)GetPixelDataSize(image.width, image.height, image.format);
+        slot->resident = slot->texture.id != 0;
+        if (slot->resident) track_alloc(MEM_ASSETS, MEM_GPU, texture_bytes(slot->texture));
+        UnloadImage(image);
+        break;
+    }
+    case RESOURCE_MODEL:
+        // Mapped from the host's shared store, otherwise a private copy. Never evicted,
+        // so private copies can live in the session arena
+        if (id == RES_NEURAL_NETWORK)
+        {
+            const NeuralNetwork* shared = shared_neural_network();
+            NeuralNetwork* nn = shared ? NULL : arena_alloc(&session_arena, MEM_AI, sizeof(NeuralNetwork));
+            slot->bytes = sizeof(NeuralNetwork);
+            slot->resident = shared || (nn && read_model(nn));
+            if (slot->resident) manager.models.neural_network = shared ? shared : nn;
+        }
+        else
+        {
+            const BayesModel* shared = shared_bayes_model();
+            BayesModel* model = shared ? NULL : arena_alloc(&session_arena, MEM_AI, sizeof(BayesModel));
+            slot->bytes = sizeof(BayesModel);
+            slot->resident = shared || (model && read_naive_bayes(model));
+            if (slot->resident) manager.models.bayes_model = shared ? shared : model;
+        }
+        break;
+    }
+
+    if (!slot->resident)
+    {
+        TraceLog(LOG_WARNING, "Failed to load resource %s", info->path);
+        slot->failed = true;
+        slot->bytes = 0;
+        return;
+    }
+    manager.resident_bytes += slot->bytes;
+    TraceLog(LOG_INFO, "Loaded %s, %zu bytes, %zu resident", info->path, slot->bytes, manager.resident_bytes);
+}
+
+static void unload_resource(const ResourceId id)
+{
+    ResourceSlot* slot = &manager.slots[id];
+    if (!slot->resident) return;
+
+    switch (RESOURCE_INFO[id].kind)
+    {
+    case RESOURCE_TEXTURE:
+        track_free(MEM_ASSETS, MEM_GPU, texture_bytes(slot->texture));
+        UnloadTexture(slot->texture);
+        slot->texture = (Texture2D){0};
+        break;
+    case RESOURCE_MODEL:
+        // Returned with the session arena
+        if (id == RES_NEURAL_NETWORK) manager.models.neural_network = NULL;
+        else manager.models.bayes_model = NULL;
+        break;
+    }
+
+    manager.resident_bytes -= slot->bytes;
+    slot->bytes = 0;
+    slot->resident = false;
+}
+
+/**
+ * @brief Makes a resource resident and marks it as used
+ */
+static ResourceSlot* touch_resource(const ResourceId id)
+{
+    ResourceSlot* slot = &manager.slots[id];
+    if (!slot->resident && !slot->failed) load_resource(id);
+    slot->last_used = ++manager.use_clock;
+    return slot;
+}
+
+/**
+ * @brief Unloads least recently used, unreferenced resources until the budget is met
+ */
+static void enforce_budget(void)
+{
+    while (manager.resident_bytes > manager.budget)
+    {
+        int victim = -1;
+        for (int i = 0; i < RES_COUNT; i++)
+        {
+            const ResourceSlot* slot = &manager.slots[i];
+            if (!slot->resident || slot->refs > 0 || RESOURCE_INFO[i].kind == RESOURCE_MODEL) continue;
+            if (victim < 0 || slot->last_used < manager.slots[victim].last_used) victim = i;
+        }
+        if (victim < 0) return;
+
+        TraceLog(LOG_INFO, "Evicting %s, %zu bytes", RESOURCE_INFO[victim].path, manager.slots[victim].bytes);
+        unload_resource(victim);
+    }
+}
+
+/**
+ * @brief Resources needed by a state, as a bit mask of ResourceId
+ */
+static uint32_t scope_resources(const GameState state, const GameMode mode)
+{
+    uint32_t mask = 0;
+    switch (state)
+    {
+    case MENU_INSTRUCTIONS:
+        mask = RESOURCE_BIT(RES_INSTRUCTIONS_1) | RESOURCE_BIT(RES_INSTRUCTIONS_2);
+        break;
+    case GAME_STATE_PLAYING:
+    case GAME_STATE_P1_WIN:
+    case GAME_STATE_P2_WIN:
+    case GAME_STATE_DRAW:
+        if (mode == ONE_PLAYER_EASY_NN) mask |= RESOURCE_BIT(RES_NEURAL_NETWORK);
+        if (mode == ONE_PLAYER_EASY_NAIVE) mask |= RESOURCE_BIT(RES_BAYES_MODEL);
+        break;
+    default:
+        break;
+    }
+    return mask;
+}
+
+/**
+ * @brief Starts the resource manager with nothing resident
+ *
+ * @param budget_bytes Resident bytes, referenced resources and models included, above
+ * which the least recently used unreferenced resources are evicted
+ */
+void init_resource_manager(const size_t budget_bytes)
+{
+    memset(&manager, 0, sizeof(manager));
+    manager.budget = budget_bytes;
+}
+
+/**
+ * @brief Unloads every resource, including the models
+ *
+ * @details Stop every thread using resource_models() first
+ */
+void cleanup_resource_manager(void)
+{
+    for (int i = 0; i < RES_COUNT; i++)
+    {
+        unload_resource(i);
+    }
+    detach_model_store();
+    manager.scope_mask = 0;
+}
+
+/**
+ * @brief Returns the models, fields are NULL until the model is acquired
+ *
+ * @details The pointer stays valid until cleanup_resource_manager()
+ */
+AiModels* resource_models(void)
+{
+    return &manager.models;
+}
+
+/**
+ * @brief Takes a reference, loading the resource if needed
+ */
+void acquire_resource(const ResourceId id)
+{
+    touch_resource(id)->refs++;
+    enforce_budget();
+}
+
+/**
+ * @brief Drops a reference, the resource stays cached until evicted
+ */
+void release_resource(const ResourceId id)
+{
+    ResourceSlot* slot = &manager.slots[id];
+    if (slot->refs > 0) slot->refs--;
+    enforce_budget();
+}
+
+/**
+ * @brief Holds the resources needed by the current state and game mode
+ *
+ * @param state Current game state
+ * @param mode Selected game mode
+ *
+ * @details Cheap when nothing changed, call it once per update
+ */
+void set_resource_scope(const GameState state, const GameMode mode)
+{
+    const uint32_t mask = scope_resources(state, mode);
+    if (mask == manager.scope_mask) return;
+
+    const uint32_t added = mask & ~manager.scope_mask;
+    const uint32_t removed = manager.scope_mask & ~mask;
+    manager.scope_mask = mask;
+
+    // Every reference is taken before the budget is enforced, so a cached resource of
+    // the new scope is not evicted while its neighbours load
+    for (int i = 0; i < RES_COUNT; i++)
+    {
+        if (added & RESOURCE_BIT(i)) touch_resource(i)->refs++;
+    }
+    for (int i = 0; i < RES_COUNT; i++)
+    {
+        if ((removed & RESOURCE_BIT(i)) && manager.slots[i].refs > 0) manager.slots[i].refs--;
+    }
+    enforce_budget();
+}
+
+/**
+ * @brief Returns a texture resource, loading it on first use
+ *
+ * @return The texture, id 0 if it failed to load
+ */
+Texture2D get_texture_resource(const ResourceId id)
+{
+    return touch_resource(id)->texture;
+}
+
+size_t resident_resource_bytes(void)
+{
+    return manager.resident_bytes;
+}
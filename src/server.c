@@ -0,0 +1,805 @@
+/**
+ * @file server.c
+ * @brief Local engine server answering best move requests over a Unix domain socket
+ *
+ * One epoll loop multiplexes every client session, decoded requests are handed to
+ * a pool of engine worker threads and the finished responses are fed back to the
+ * loop through an eventfd. Models and the best move cache are loaded once and
+ * shared by all sessions.
+ */
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include <server.h>
+#include <computer.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_EPOLL_EVENTS 256
+#define LISTEN_BACKLOG 1024
+#define SESSION_READ_BUFFER 4096
+#define SESSION_MAX_IN_FLIGHT 1024
+#define STATS_LOG_INTERVAL 5.0
+
+typedef struct Session {
+    int fd;
+    uint32_t events;         // Events currently registered with epoll
+    bool closed;             // fd is closed, waiting for in flight jobs before free
+    bool peer_done;          // Client closed its write side, finish after last response
+    bool dirty;              // Queued on the flush list of the current drain
+    size_t in_flight;
+    uint8_t in_buf[SESSION_READ_BUFFER];
+    size_t in_len;
+    uint8_t* out_buf;
+    size_t out_len;
+    size_t out_cap;
+    struct Session* prev;
+    struct Session* next;
+    struct Session* next_dirty;
+} Session;
+
+typedef struct EngineJob {
+    struct EngineJob* next;
+    Session* session;
+    double received_at;
+    EngineRequest request;
+    EngineResponse response;
+} EngineJob;
+
+typedef struct {
+    EngineJob* head;
+    EngineJob* tail;
+} JobQueue;
+
+typedef struct {
+    uint32_t key;
+    EvalResult result;
+    UT_hash_handle hh;
+} MoveCacheEntry;
+
+typedef struct {
+    const AiModels* models;
+
+    pthread_mutex_t pending_lock;
+    pthread_cond_t pending_ready;
+    JobQueue pending;
+    bool stopping;
+
+    pthread_mutex_t done_lock;
+    JobQueue done;
+    int done_fd;
+
+    pthread_rwlock_t cache_lock;
+    MoveCacheEntry* cache;
+
+    pthread_t* workers;
+    int worker_count;
+
+    int epoll_fd;
+    int listen_fd;
+    Session* sessions;
+    Session* retired;
+    size_t session_count;
+
+    // Latency statistics since the last summary line
+    double stats_since;
+    uint64_t stats_requests;
+    uint64_t stats_total_us;
+    uint32_t stats_max_us;
+} EngineServer;
+
+// Sentinels stored in epoll_event.data.ptr to tell the non session fds apart
+static int LISTEN_TAG;
+static int DONE_TAG;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(const int signal)
+{
+    (void)signal;
+    stop_requested = 1;
+}
+
+static double monotonic_seconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static void queue_push(JobQueue* queue, EngineJob* job)
+{
+    job->next = NULL;
+    if (queue->tail)
+    {
+        queue->tail->next = job;
+    }
+    else
+    {
+        queue->head = job;
+    }
+    queue->tail = job;
+}
+
+static void queue_free(JobQueue* queue)
+{
+    EngineJob* job = queue->head;
+    while (job)
+    {
+        EngineJob* next = job->next;
+        free(job);
+        job = next;
+    }
+    queue->head = NULL;
+    queue->tail = NULL;
+}
+
+/**
+ * @brief Checks a request is a legal position for a known engine
+ */
+static bool is_valid_request(const EngineRequest* request)
+{
+    if (request->x_board & request->o_board) return false;
+    if ((request->x_board | request->o_board) & ~0b111111111) return false;
+    if (request->computer_player != PLAYER_X && request->computer_player != PLAYER_O) return false;
+    return request->engine == ONE_PLAYER_EASY_NN || request->engine == ONE_PLAYER_EASY_NAIVE ||
+           request->engine == ONE_PLAYER_MEDIUM || request->engine == ONE_PLAYER_HARD;
+}
+
+/**
+ * @brief Runs the requested engine on a worker thread
+ *
+ * @param server Server owning the shared models and best move cache
+ * @param request Decoded request
+ * @return Response with every field but latency_us filled in
+ *
+ * @details
+ * All engines are deterministic, so answers are cached by position, engine and side
+ * to move and shared between every session.
+ */
+static EngineResponse evaluate_request(EngineServer* server, const EngineRequest* request)
+{
+    EngineResponse response = {
+        .request_id = request->request_id,
+        .move = -1,
+        .status = ENGINE_STATUS_OK,
+        .score_milli = 0,
+        .latency_us = 0
+    };
+
+    if (!is_valid_request(request))
+    {
+        response.status = ENGINE_STATUS_BAD_REQUEST;
+        return response;
+    }
+
+    // Boards are thread-local, this only changes the worker's own copy
+    x_board = request->x_board;
+    o_board = request->o_board;
+
+    if (check_win(PLAYER_X) != -1 || check_win(PLAYER_O) != -1 || check_draw())
+    {
+        response.status = ENGINE_STATUS_NO_MOVE;
+        return response;
+    }
+
+    const uint32_t key = (uint32_t)request->x_board | (uint32_t)request->o_board << 9 |
+                         (uint32_t)request->engine << 18 | (uint32_t)request->computer_player << 21;
+
+    MoveCacheEntry* entry = NULL;
+    EvalResult result;
+
+    pthread_rwlock_rdlock(&server->cache_lock);
+    HASH_FIND(hh, server->cache, &key, sizeof(key), entry);
+    if (entry) result = entry->result;
+    pthread_rwlock_unlock(&server->cache_lock);
+
+    if (!entry)
+    {
+        const GameContext context = {
+            .selected_game_mode = (GameMode)request->engine,
+            .computer_enabled = true,
+            .player_1 = request->computer_player == PLAYER_X ? PLAYER_O : PLAYER_X,
+        };
+        result = choose_computer_move(&context, server->models, NULL);
+
+        MoveCacheEntry* new_entry = malloc(sizeof(MoveCacheEntry));
+        if (new_entry)
+        {
+            new_entry->key = key;
+            new_entry->result = result;
+
+            pthread_rwlock_wrlock(&server->cache_lock);
+            HASH_FIND(hh, server->cache, &key, sizeof(key), entry);
+            if (entry)
+            {
+                free(new_entry); // Another worker got there first
+            }
+            else
+            {
+                HASH_ADD(hh, server->cache, key, sizeof(key), new_entry);
+            }
+            pthread_rwlock_unlock(&server->cache_lock);
+        }
+    }
+
+    const double score = result.score * 1000.0;
+    response.move = (int8_t)result.move;
+    response.status = result.move == -1 ? ENGINE_STATUS_NO_MOVE : ENGINE_STATUS_OK;
+    response.score_milli = (int16_t)(score > INT16_MAX ? INT16_MAX : score < INT16_MIN ? INT16_MIN : score);
+    return response;
+}
+
+/**
+ * @brief Engine worker thread, evaluates pending jobs until the server stops
+ */
+static void* engine_worker(void* arg)
+{
+    EngineServer* server = arg;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&server->pending_lock);
+        while (!server->pending.head && !server->stopping)
+        {
+            pthread_cond_wait(&server->pending_ready, &server->pending_lock);
+        }
+        if (server->stopping)
+        {
+            pthread_mutex_unlock(&server->pending_lock);
+            break;
+        }
+        EngineJob* job = server->pending.head;
+        server->pending.head = job->next;
+        if (!server->pending.head) server->pending.tail = NULL;
+        pthread_mutex_unlock(&server->pending_lock);
+
+        job->response = evaluate_request(server, &job->request);
+
+        pthread_mutex_lock(&server->done_lock);
+        const bool was_empty = server->done.head == NULL;
+        queue_push(&server->done, job);
+        pthread_mutex_unlock(&server->done_lock);
+
+        // Only the first completion of a batch needs to wake the loop
+        if (was_empty)
+        {
+            const uint64_t one = 1;
+            while (write(server->done_fd, &one, sizeof(one)) < 0 && errno == EINTR) {}
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Registers the epoll interest matching a session's current state
+ */
+static void update_session_events(const EngineServer* server, Session* session)
+{
+    uint32_t events = 0;
+    if (!session->peer_done && session->in_flight < SESSION_MAX_IN_FLIGHT) events |= EPOLLIN;
+    if (session->out_len > 0) events |= EPOLLOUT;
+
+    if (events != session->events)
+    {
+        struct epoll_event event = {.events = events, .data.ptr = session};
+        epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, session->fd, &event);
+        session->events = events;
+    }
+}
+
+static void unlink_session(Session** list, Session* session)
+{
+    if (session->prev)
+    {
+        session->prev->next = session->next;
+    }
+    else
+    {
+        *list = session->next;
+    }
+    if (session->next) session->next->prev = session->prev;
+    session->prev = NULL;
+    session->next = NULL;
+}
+
+static void link_session(Session** list, Session* session)
+{
+    session->prev = NULL;
+    session->next = *list;
+    if (*list) (*list)->prev = session;
+    *list = session;
+}
+
+/**
+ * @brief Moves a closed session without outstanding jobs to the list freed after this loop iteration
+ *
+ * @details
+ * Freeing is deferred because later events of the same epoll batch may still point at the session.
+ */
+static void retire_session(EngineServer* server, Session* session)
+{
+    unlink_session(&server->sessions, session);
+    link_session(&server->retired, session);
+    server->session_count--;
+}
+
+static void free_retired_sessions(EngineServer* server)
+{
+    while (server->retired)
+    {
+        Session* session = server->retired;
+        unlink_session(&server->retired, session);
+        free(session->out_buf);
+        free(session);
+    }
+}
+
+/**
+ * @brief Closes a session's socket, memory is released once its last job returns
+ */
+static void close_session(EngineServer* server, Session* session)
+{
+    if (session->closed) return;
+
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, session->fd, NULL);
+    close(session->fd);
+    session->closed = true;
+    if (session->in_flight == 0) retire_session(server, session);
+}
+
+/**
+ * @brief Writes as much queued output as the socket accepts
+ */
+static void flush_session(EngineServer* server, Session* session)
+{
+    size_t sent = 0;
+    while (sent < session->out_len)
+    {
+        const ssize_t written = send(session->fd, session->out_buf + sent, session->out_len - sent, MSG_NOSIGNAL);
+        if (written > 0)
+        {
+            sent += (size_t)written;
+        }
+        else if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        else
+        {
+            close_session(server, session);
+            return;
+        }
+    }
+
+    memmove(session->out_buf, session->out_buf + sent, session->out_len - sent);
+    session->out_len -= sent;
+
+    if (session->peer_done && session->in_flight == 0 && session->out_len == 0)
+    {
+        close_session(server, session);
+        return;
+    }
+    update_session_events(server, session);
+}
+
+static bool append_response(Session* session, const EngineResponse* response)
+{
+    if (session->out_len + sizeof(EngineResponse) > session->out_cap)
+    {
+        const size_t new_cap = session->out_cap ? session->out_cap * 2 : sizeof(EngineResponse) * 64;
+        uint8_t* grown = realloc(session->out_buf, new_cap);
+        if (!grown) return false;
+        session->out_buf = grown;
+        session->out_cap = new_cap;
+    }
+    memcpy(session->out_buf + session->out_len, response, sizeof(EngineResponse));
+    session->out_len += sizeof(EngineResponse);
+    return true;
+}
+
+/**
+ * @brief Reads and decodes every complete request available on a session
+ *
+ * @details
+ * Decoded jobs are batched and handed to the worker pool under a single lock.
+ * Reading pauses once SESSION_MAX_IN_FLIGHT requests are outstanding.
+ */
+static void read_session(EngineServer* server, Session* session)
+{
+    JobQueue batch = {0};
+    size_t batch_size = 0;
+
+    while (!session->peer_done && session->in_flight + batch_size < SESSION_MAX_IN_FLIGHT)
+    {
+        const ssize_t received = read(session->fd, session->in_buf + session->in_len,
+                                      sizeof(session->in_buf) - session->in_len);
+        if (received == 0)
+        {
+            session->peer_done = true;
+            break;
+        }
+        if (received < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                queue_free(&batch);
+                close_session(server, session);
+                return;
+            }
+            break;
+        }
+        session->in_len += (size_t)received;
+
+        const double now = monotonic_seconds();
+        size_t offset = 0;
+        while (session->in_len - offset >= sizeof(EngineRequest))
+        {
+            EngineJob* job = malloc(sizeof(EngineJob));
+            if (!job) break;
+            job->session = session;
+            job->received_at = now;
+            memcpy(&job->request, session->in_buf + offset, sizeof(EngineRequest));
+            queue_push(&batch, job);
+            batch_size++;
+            offset += sizeof(EngineRequest);
+        }
+        memmove(session->in_buf, session->in_buf + offset, session->in_len - offset);
+        session->in_len -= offset;
+    }
+
+    if (batch.head)
+    {
+        session->in_flight += batch_size;
+
+        pthread_mutex_lock(&server->pending_lock);
+        if (server->pending.tail)
+        {
+            server->pending.tail->next = batch.head;
+        }
+        else
+        {
+            server->pending.head = batch.head;
+        }
+        server->pending.tail = batch.tail;
+        pthread_cond_broadcast(&server->pending_ready);
+        pthread_mutex_unlock(&server->pending_lock);
+    }
+
+    if (session->peer_done && session->in_flight == 0 && session->out_len == 0)
+    {
+        close_session(server, session);
+        return;
+    }
+    update_session_events(server, session);
+}
+
+/**
+ * @brief Accepts every pending connection on the listening socket
+ */
+static void accept_sessions(EngineServer* server)
+{
+    for (;;)
+    {
+        const int fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EMFILE || errno == ENFILE)
+            {
+                TraceLog(LOG_WARNING, "Engine server: out of file descriptors, %zu sessions open",
+                         server->session_count);
+            }
+            return;
+        }
+
+        Session* session = calloc(1, sizeof(Session));
+        if (!session)
+        {
+            close(fd);
+            continue;
+        }
+        session->fd = fd;
+        session->events = EPOLLIN;
+
+        struct epoll_event event = {.events = EPOLLIN, .data.ptr = session};
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            close(fd);
+            free(session);
+            continue;
+        }
+
+        link_session(&server->sessions, session);
+        server->session_count++;
+    }
+}
+
+/**
+ * @brief Moves finished jobs into their sessions' output buffers and flushes them
+ */
+static void drain_completions(EngineServer* server)
+{
+    uint64_t wakeups;
+    while (read(server->done_fd, &wakeups, sizeof(wakeups)) < 0 && errno == EINTR) {}
+
+    pthread_mutex_lock(&server->done_lock);
+    EngineJob* job = server->done.head;
+    server->done.head = NULL;
+    server->done.tail = NULL;
+    pthread_mutex_unlock(&server->done_lock);
+
+    Session* dirty = NULL;
+    const double now = monotonic_seconds();
+
+    while (job)
+    {
+        EngineJob* next = job->next;
+        Session* session = job->session;
+        session->in_flight--;
+
+        if (session->closed)
+        {
+            if (session->in_flight == 0) retire_session(server, session);
+        }
+        else
+        {
+            const double latency = (now - job->received_at) * 1e6;
+            job->response.latency_us = latency > UINT32_MAX ? UINT32_MAX : (uint32_t)latency;
+
+            TraceLog(LOG_DEBUG, "Engine request %u: engine %u move %d in %u us", job->request.request_id,
+                     job->request.engine, job->response.move, job->response.latency_us);
+
+            server->stats_requests++;
+            server->stats_total_us += job->response.latency_us;
+            if (job->response.latency_us > server->stats_max_us) server->stats_max_us = job->response.latency_us;
+
+            if (append_response(session, &job->response) && !session->dirty)
+            {
+                session->dirty = true;
+                session->next_dirty = dirty;
+                dirty = session;
+            }
+        }
+        free(job);
+        job = next;
+    }
+
+    while (dirty)
+    {
+        Session* next = dirty->next_dirty;
+        dirty->dirty = false;
+        if (!dirty->closed) flush_session(server, dirty);
+        dirty = next;
+    }
+}
+
+static void log_server_stats(EngineServer* server, const double now)
+{
+    const double elapsed = now - server->stats_since;
+    if (elapsed < STATS_LOG_INTERVAL) return;
+
+    if (server->stats_requests > 0)
+    {
+        TraceLog(LOG_INFO, "Engine server: %llu requests in %.1fs, mean latency %.1f us, max %u us, %zu sessions",
+                 (unsigned long long)server->stats_requests, elapsed,
+                 (double)server->stats_total_us / (double)server->stats_requests, server->stats_max_us,
+                 server->session_count);
+    }
+    server->stats_since = now;
+    server->stats_requests = 0;
+    server->stats_total_us = 0;
+    server->stats_max_us = 0;
+}
+
+static int open_listen_socket(const char* socket_path)
+{
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+    if (strlen(socket_path) >= sizeof(address.sun_path))
+    {
+        TraceLog(LOG_ERROR, "Engine server: socket path too long: %s", socket_path);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    unlink(socket_path); // Remove a stale socket left by a previous run
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(fd, LISTEN_BACKLOG) < 0)
+    {
+        TraceLog(LOG_ERROR, "Engine server: cannot listen on %s: %s", socket_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool start_workers(EngineServer* server)
+{
+    const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    server->worker_count = cpus > 0 ? (int)cpus : 1;
+    server->workers = calloc((size_t)server->worker_count, sizeof(pthread_t));
+    if (!server->workers) return false;
+
+    // Workers must not receive SIGINT/SIGTERM, the loop thread handles them
+    sigset_t blocked, previous;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &blocked, &previous);
+
+    int started = 0;
+    while (started < server->worker_count &&
+           pthread_create(&server->workers[started], NULL, engine_worker, server) == 0)
+    {
+        started++;
+    }
+    server->worker_count = started;
+
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+    return started > 0;
+}
+
+static void stop_workers(EngineServer* server)
+{
+    pthread_mutex_lock(&server->pending_lock);
+    server->stopping = true;
+    pthread_cond_broadcast(&server->pending_ready);
+    pthread_mutex_unlock(&server->pending_lock);
+
+    for (int i = 0; i < server->worker_count; i++)
+    {
+        pthread_join(server->workers[i], NULL);
+    }
+    free(server->workers);
+    server->workers = NULL;
+}
+
+/**
+ * @brief Serves best move requests until SIGINT or SIGTERM
+ *
+ * @param socket_path Filesystem path of the Unix domain socket to listen on
+ * @return EXIT_SUCCESS on clean shutdown, EXIT_FAILURE if the server could not start
+ */
+int run_engine_server(const char* socket_path)
+{
+    EngineServer server = {
+        .pending_lock = PTHREAD_MUTEX_INITIALIZER,
+        .pending_ready = PTHREAD_COND_INITIALIZER,
+        .done_lock = PTHREAD_MUTEX_INITIALIZER,
+        .cache_lock = PTHREAD_RWLOCK_INITIALIZER,
+        .done_fd = -1,
+        .epoll_fd = -1,
+        .listen_fd = -1,
+    };
+    int status = EXIT_FAILURE;
+
+    struct sigaction stop_action = {.sa_handler = handle_stop_signal};
+    sigemptyset(&stop_action.sa_mask);
+    sigaction(SIGINT, &stop_action, NULL);
+    sigaction(SIGTERM, &stop_action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    AiModels* models = load_ai_models();
+    if (!models) return EXIT_FAILURE;
+    server.models = models;
+
+    server.listen_fd = open_listen_socket(socket_path);
+    server.done_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    server.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (server.listen_fd < 0 || server.done_fd < 0 || server.epoll_fd < 0) goto cleanup;
+
+    struct epoll_event listen_event = {.events = EPOLLIN, .data.ptr = &LISTEN_TAG};
+    struct epoll_event done_event = {.events = EPOLLIN, .data.ptr = &DONE_TAG};
+    if (epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.listen_fd, &listen_event) < 0 ||
+        epoll_ctl(server.epoll_fd, EPOLL_CTL_ADD, server.done_fd, &done_event) < 0)
+    {
+        goto cleanup;
+    }
+
+    if (!start_workers(&server))
+    {
+        TraceLog(LOG_ERROR, "Engine server: failed to start worker threads");
+        goto cleanup;
+    }
+
+    TraceLog(LOG_INFO, "Engine server listening on %s with %d workers", socket_path, server.worker_count);
+    server.stats_since = monotonic_seconds();
+
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    while (!stop_requested)
+    {
+        const int ready = epoll_wait(server.epoll_fd, events, MAX_EPOLL_EVENTS, 1000);
+        if (ready < 0 && errno != EINTR) break;
+
+        for (int i = 0; i < ready; i++)
+        {
+            if (events[i].data.ptr == &LISTEN_TAG)
+            {
+                accept_sessions(&server);
+            }
+            else if (events[i].data.ptr == &DONE_TAG)
+            {
+                drain_completions(&server);
+            }
+            else
+            {
+                Session* session = events[i].data.ptr;
+                if (session->closed) continue;
+
+                if (events[i].events & (EPOLLERR | EPOLLHUP))
+                {
+                    close_session(&server, session);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) read_session(&server, session);
+                if (!session->closed && events[i].events & EPOLLOUT) flush_session(&server, session);
+            }
+        }
+        free_retired_sessions(&server);
+        log_server_stats(&server, monotonic_seconds());
+    }
+
+    TraceLog(LOG_INFO, "Engine server shutting down");
+    stop_workers(&server);
+    status = EXIT_SUCCESS;
+
+cleanup:
+    queue_free(&server.pending);
+    queue_free(&server.done);
+    while (server.sessions)
+    {
+        Session* session = server.sessions;
+        if (!session->closed) close(session->fd);
+        retire_session(&server, session);
+    }
+    free_retired_sessions(&server);
+
+    MoveCacheEntry *entry, *tmp;
+    HASH_ITER(hh, server.cache, entry, tmp)
+    {
+        HASH_DEL(server.cache, entry);
+        free(entry);
+    }
+
+    if (server.listen_fd >= 0)
+    {
+        close(server.listen_fd);
+        unlink(socket_path);
+    }
+    if (server.done_fd >= 0) close(server.done_fd);
+    if (server.epoll_fd >= 0) close(server.epoll_fd);
+    unload_ai_models(models);
+    return status;
+}
+
+#else
+
+#include <stdlib.h>
+
+int run_engine_server(const char* socket_path)
+{
+    TraceLog(LOG_ERROR, "Engine server is only supported on Linux, cannot listen on %s", socket_path);
+    return EXIT_FAILURE;
+}
+
+#endif
@@ -0,0 +1,418 @@
+/**
+ * @file spectator.c
+ * @brief Spectator wall, many engine-vs-engine matches shown at once
+ *
+ * Worker threads each own a slice of the matches and play them on their own
+ * thread-local boards. After every move a worker publishes the board as one atomic
+ * 32-bit snapshot, so the renderer copies a consistent board without locking.
+ * The whole wall is drawn as a single run of triangles in an rlgl batch.
+ */
+#include <spectator.h>
+#include <arena.h>
+#include <computer.h>
+#include <game.h>
+
+#include <math.h>
+#include <pthread.h>
+#include <rlgl.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NO_PATTERN 15
+
+// Engines that can play a match, two-player mode is not an engine
+static const GameMode SPECTATOR_ENGINES[] = {
+    ONE_PLAYER_EASY_NAIVE, ONE_PLAYER_EASY_NN, ONE_PLAYER_MEDIUM, ONE_PLAYER_HARD
+};
+#define ENGINE_COUNT (int)(sizeof(SPECTATOR_ENGINES) / sizeof(SPECTATOR_ENGINES[0]))
+
+typedef struct {
+    uint16_t x;
+    uint16_t o;
+    player_t to_move;
+    GameMode engines[2]; // Engine playing X, engine playing O
+    SpectatorStatus status;
+    int pattern;
+    int games_played;
+    double result_time; // When the finished board appeared
+} Match;
+
+typedef struct {
+    SpectatorWall* wall;
+    int first;
+    int count;
+    Match* matches;
+    uint32_t seed;
+    pthread_t thread;
+    bool started;
+} SpectatorShard;
+
+struct SpectatorWall {
+    const AiModels* models;
+    int board_count;
+    _Atomic BoardSnapshot* snapshots;
+    SpectatorShard shards[SPECTATOR_THREADS];
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stopping; // Guarded by lock
+};
+
+/**
+ * @brief Small per-thread xorshift generator, rand() is not thread-safe
+ */
+static uint32_t next_random(uint32_t* state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static BoardSnapshot pack_snapshot(const Match* match)
+{
+    return (BoardSnapshot)match->x | (BoardSnapshot)match->o << 9 | (BoardSnapshot)match->status << 18 |
+        (BoardSnapshot)match->pattern << 20 | (BoardSnapshot)(match->games_played & 0xFF) << 24;
+}
+
+/**
+ * @brief Clears a match and picks new engines, the opening move is random so games differ
+ */
+static void start_match(Match* match, uint32_t* seed)
+{
+    match->engines[0] = SPECTATOR_ENGINES[next_random(seed) % ENGINE_COUNT];
+    match->engines[1] = SPECTATOR_ENGINES[next_random(seed) % ENGINE_COUNT];
+    match->status = SPECTATOR_PLAYING;
+    match->pattern = NO_PATTERN;
+
+    match->x = (uint16_t)(1 << next_random(seed) % 9);
+    match->o = 0;
+    match->to_move = PLAYER_O;
+}
+
+/**
+ * @brief Plays one move of a match on this thread's board
+ *
+ * @param match Match to advance
+ * @param models Models shared by all engines, read only
+ */
+static void play_move(Match* match, const AiModels* models)
+{
+    x_board = match->x;
+    o_board = match->o;
+
+    // The engine plays the computer's side, so the human is the other player
+    const GameContext context = {
+        .selected_game_mode = match->engines[match->to_move == PLAYER_X ? 0 : 1],
+        .player_1 = match->to_move == PLAYER_X ? PLAYER_O : PLAYER_X,
+        .computer_enabled = true,
+    };
+    const EvalResult result = choose_computer_move(&context, models, NULL);
+
+    if (result.move >= 0 && result.move < 9 && !((x_board | o_board) >> result.move & 1))
+    {
+        if (match->to_move == PLAYER_X) x_board |= (uint16_t)(1 << result.move);
+        else o_board |= (uint16_t)(1 << result.move);
+    }
+
+    const int pattern = check_win(match->to_move);
+    if (pattern != -1)
+    {
+        match->status = match->to_move == PLAYER_X ? SPECTATOR_X_WON : SPECTATOR_O_WON;
+        match->pattern = pattern;
+    }
+    else if (check_draw() || result.move < 0)
+    {
+        match->status = SPECTATOR_DRAW;
+    }
+
+    match->x = x_board;
+    match->o = o_board;
+    match->to_move = match->to_move == PLAYER_X ? PLAYER_O : PLAYER_X;
+}
+
+/**
+ * @brief Worker loop, advances every match of its shard once per move interval
+ */
+static void* spectator_main(void* arg)
+{
+    SpectatorShard* shard = arg;
+    SpectatorWall* wall = shard->wall;
+
+    Match* matches = shard->matches;
+
+    for (int i = 0; i < shard->count; i++)
+    {
+        start_match(&matches[i], &shard->seed);
+        atomic_store_explicit(&wall->snapshots[shard->first + i], pack_snapshot(&matches[i]), memory_order_release);
+    }
+
+    pthread_mutex_lock(&wall->lock);
+    while (!wall->stopping)
+    {
+        pthread_mutex_unlock(&wall->lock);
+
+        const double now = now_seconds();
+        for (int i = 0; i < shard->count; i++)
+        {
+            Match* match = &matches[i];
+            if (match->status == SPECTATOR_PLAYING)
+            {
+                play_move(match, wall->models);
+                if (match->status != SPECTATOR_PLAYING) match->result_time = now;
+            }
+            else if (now - match->result_time >= SPECTATOR_RESULT_SECONDS)
+            {
+                match->games_played++;
+                start_match(match, &shard->seed);
+            }
+            atomic_store_explicit(&wall->snapshots[shard->first + i], pack_snapshot(match), memory_order_release);
+        }
+
+        // Pace the matches so they can be followed, wakes early on shutdown
+        const double deadline = now + SPECTATOR_MOVE_SECONDS;
+        struct timespec until = {
+            .tv_sec = (time_t)deadline,
+            .tv_nsec = (long)((deadline - floor(deadline)) * 1e9)
+        };
+        pthread_mutex_lock(&wall->lock);
+        if (!wall->stopping) pthread_cond_timedwait(&wall->wake, &wall->lock, &until);
+    }
+    pthread_mutex_unlock(&wall->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts the spectator matches
+ *
+ * @param models Models shared by all engines, must outlive the wall
+ * @param board_count Number of boards, clamped to 1..SPECTATOR_MAX_BOARDS
+ * @return Pointer to the wall, NULL on failure
+ */
+SpectatorWall* init_spectator_wall(const AiModels* models, int board_count)
+{
+    if (board_count < 1) board_count = 1;
+    if (board_count > SPECTATOR_MAX_BOARDS) board_count = SPECTATOR_MAX_BOARDS;
+
+    SpectatorWall* wall = arena_alloc(&session_arena, MEM_AI, sizeof(SpectatorWall));
+    if (!wall) return NULL;
+
+    // Matches are only touched by their worker, snapshots are published atomically
+    wall->snapshots = arena_calloc(&session_arena, MEM_AI, (size_t)board_count, sizeof(*wall->snapshots));
+    Match* matches = arena_calloc(&session_arena, MEM_AI, (size_t)board_count, sizeof(Match));
+    if (!wall->snapshots || !matches) return NULL;
+    wall->models = models;
+    wall->board_count = board_count;
+    pthread_mutex_init(&wall->lock, NULL);
+    pthread_cond_init(&wall->wake, NULL);
+
+    // The timed wait paces the workers against the realtime clock
+    const int threads = board_count < SPECTATOR_THREADS ? board_count : SPECTATOR_THREADS;
+    int first = 0;
+    for (int i = 0; i < threads; i++)
+    {
+        SpectatorShard* shard = &wall->shards[i];
+        shard->wall = wall;
+        shard->first = first;
+        shard->count = board_count / threads + (i < board_count % threads ? 1 : 0);
+        shard->matches = matches + first;
+        shard->seed = (uint32_t)time(NULL) * 2654435761u + (uint32_t)i * 40503u + 1u;
+        first += shard->count;
+
+        shard->started = pthread_create(&shard->thread, NULL, spectator_main, shard) == 0;
+        if (!shard->started)
+        {
+            TraceLog(LOG_WARNING, "Failed to start spectator worker %d", i);
+        }
+    }
+
+    TraceLog(LOG_INFO, "Spectator wall: %d boards on %d workers", board_count, threads);
+    return wall;
+}
+
+/**
+ * @brief Stops the workers, the wall's memory belongs to the session arena
+ *
+ * @param wall Pointer to the wall, may be NULL
+ */
+void cleanup_spectator_wall(SpectatorWall* wall)
+{
+    if (!wall) return;
+
+    pthread_mutex_lock(&wall->lock);
+    wall->stopping = true;
+    pthread_cond_broadcast(&wall->wake);
+    pthread_mutex_unlock(&wall->lock);
+
+    for (int i = 0; i < SPECTATOR_THREADS; i++)
+    {
+        if (wall->shards[i].started) pthread_join(wall->shards[i].thread, NULL);
+    }
+
+    pthread_cond_destroy(&wall->wake);
+    pthread_mutex_destroy(&wall->lock);
+}
+
+int spectator_board_count(const SpectatorWall* wall)
+{
+    return wall->board_count;
+}
+
+/**
+ * @brief Copies the latest snapshot of every board
+ *
+ * @param wall Pointer to the wall
+ * @param out Array of spectator_board_count() snapshots
+ */
+void spectator_snapshots(const SpectatorWall* wall, BoardSnapshot* out)
+{
+    for (int i = 0; i < wall->board_count; i++)
+    {
+        out[i] = atomic_load_explicit(&wall->snapshots[i], memory_order_acquire);
+    }
+}
+
+/**
+ * @brief Emits a thick line as two triangles
+ */
+static void emit_line(const Vector2 a, const Vector2 b, const float thickness)
+{
+    const float dx = b.x - a.x, dy = b.y - a.y;
+    const float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0) return;
+
+    const float nx = -dy / length * thickness / 2, ny = dx / length * thickness / 2;
+
+    // Counter-clockwise on screen, as rlgl expects
+    rlVertex2f(a.x + nx, a.y + ny);
+    rlVertex2f(b.x - nx, b.y - ny);
+    rlVertex2f(a.x - nx, a.y - ny);
+    rlVertex2f(a.x + nx, a.y + ny);
+    rlVertex2f(b.x + nx, b.y + ny);
+    rlVertex2f(b.x - nx, b.y - ny);
+}
+
+/**
+ * @brief Emits a ring as triangles
+ */
+static void emit_ring(const Vector2 center, const float inner, const float outer, const int segments)
+{
+    for (int i = 0; i < segments; i++)
+    {
+        const float a0 = 2 * PI * (float)i / (float)segments;
+        const float a1 = 2 * PI * (float)(i + 1) / (float)segments;
+        const Vector2 i0 = {center.x + cosf(a0) * inner, center.y + sinf(a0) * inner};
+        const Vector2 o0 = {center.x + cosf(a0) * outer, center.y + sinf(a0) * outer};
+        const Vector2 i1 = {center.x + cosf(a1) * inner, center.y + sinf(a1) * inner};
+        const Vector2 o1 = {center.x + cosf(a1) * outer, center.y + sinf(a1) * outer};
+
+        rlVertex2f(i0.x, i0.y);
+        rlVertex2f(o1.x, o1.y);
+        rlVertex2f(o0.x, o0.y);
+        rlVertex2f(i0.x, i0.y);
+        rlVertex2f(i1.x, i1.y);
+        rlVertex2f(o1.x, o1.y);
+    }
+}
+
+// Cells at both ends of each winning pattern, in check_win() order
+static const int PATTERN_ENDS[8][2] = {{0, 2}, {3, 5}, {6, 8}, {2, 8}, {1, 7}, {0, 6}, {0, 8}, {2, 6}};
+
+// Upper bound on the vertices of one board: 4 grid lines, 9 rings and a win line
+#define RING_SEGMENTS 16
+#define BOARD_MAX_VERTICES (6 * 4 + 9 * 6 * RING_SEGMENTS + 6)
+
+/**
+ * @brief Draws every board of the wall in one rlgl batch
+ *
+ * @param wall Pointer to the wall
+ * @param render_opts Pointer to the UiOptions
+ */
+void render_spectator_wall(const SpectatorWall* wall, const UiOptions* render_opts)
+{
+    static BoardSnapshot snapshots[SPECTATOR_MAX_BOARDS];
+    spectator_snapshots(wall, snapshots);
+
+    ClearBackground(render_opts->background_color);
+
+    const float screen_width = (float)GetScreenWidth();
+    const float screen_height = (float)GetScreenHeight();
+    const int count = wall->board_count;
+
+    // Square tiles, as many columns as keep every board on screen
+    int columns = (int)ceilf(sqrtf((float)count * screen_width / screen_height));
+    if (columns < 1) columns = 1;
+    const int rows = (count + columns - 1) / columns;
+    const float tile = fminf(screen_width / (float)columns, screen_height / (float)rows);
+    const float margin = tile * 0.1f;
+    const float board_size = tile - 2 * margin;
+    const float cell = board_size / 3;
+    const float line = fmaxf(1.0f, board_size * 0.02f);
+    const float origin_x = (screen_width - tile * (float)columns) / 2;
+    const float origin_y = (screen_height - tile * (float)rows) / 2;
+
+    rlBegin(RL_TRIANGLES);
+    for (int i = 0; i < count; i++)
+    {
+        // Flushes the batch between boards if the next one would not fit
+        rlCheckRenderBatchLimit(BOARD_MAX_VERTICES);
+
+        const BoardSnapshot snapshot = snapshots[i];
+        const float x = origin_x + (float)(i % columns) * tile + margin;
+        const float y = origin_y + (float)(i / columns) * tile + margin;
+        const SpectatorStatus status = SNAPSHOT_STATUS(snapshot);
+
+        // Grid lines, dimmed once the game is over
+        const Color grid_color = status == SPECTATOR_PLAYING ? DARKGRAY : LIGHTGRAY;
+        rlColor4ub(grid_color.r, grid_color.g, grid_color.b, grid_color.a);
+        for (int k = 1; k < 3; k++)
+        {
+            emit_line((Vector2){x + cell * (float)k, y}, (Vector2){x + cell * (float)k, y + board_size}, line);
+            emit_line((Vector2){x, y + cell * (float)k}, (Vector2){x + board_size, y + cell * (float)k}, line);
+        }
+
+        const uint16_t xs = SNAPSHOT_X(snapshot);
+        const uint16_t os = SNAPSHOT_O(snapshot);
+        const float inset = cell * 0.2f;
+        for (int c = 0; c < 9; c++)
+        {
+            const float cx = x + (float)(c % 3) * cell;
+            const float cy = y + (float)(c / 3) * cell;
+
+            if (xs >> c & 1)
+            {
+                rlColor4ub(BLUE.r, BLUE.g, BLUE.b, BLUE.a);
+                emit_line((Vector2){cx + inset, cy + inset}, (Vector2){cx + cell - inset, cy + cell - inset},
+                          line * 1.5f);
+                emit_line((Vector2){cx + cell - inset, cy + inset}, (Vector2){cx + inset, cy + cell - inset},
+                          line * 1.5f);
+            }
+            else if (os >> c & 1)
+            {
+                rlColor4ub(RED.r, RED.g, RED.b, RED.a);
+                const float radius = cell / 2 - inset;
+                emit_ring((Vector2){cx + cell / 2, cy + cell / 2}, radius - line * 1.5f, radius, RING_SEGMENTS);
+            }
+        }
+
+        const int pattern = SNAPSHOT_PATTERN(snapshot);
+        if (pattern < 8)
+        {
+            const int a = PATTERN_ENDS[pattern][0], b = PATTERN_ENDS[pattern][1];
+            rlColor4ub(GOLD.r, GOLD.g, GOLD.b, GOLD.a);
+            emit_line((Vector2){x + ((float)(a % 3) + 0.5f) * cell, y + ((float)(a / 3) + 0.5f) * cell},
+                      (Vector2){x + ((float)(b % 3) + 0.5f) * cell, y + ((float)(b / 3) + 0.5f) * cell},
+                      line * 2);
+        }
+    }
+    rlEnd();
+}
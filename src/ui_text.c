@@ -0,0 +1,187 @@
+/**
+ * @file ui_text.c
+ * @brief Resolution independent text and board symbols
+ *
+ * The glyphs of assets/ui_font.ttf are rasterised once at startup into a signed
+ * distance field atlas and drawn through an SDF shader, so labels stay crisp at any
+ * size. If the font or the shader fails to load, text falls back to raylib's default
+ * font. Board symbols are
+ * drawn as geometry and do not depend on a font at all.
+ */
+#include <asset_pak.h>
+#include <mem_stats.h>
+#include <rlgl.h>
+#include <stdlib.h>
+#include <ui_text.h>
+
+static const char SDF_FRAGMENT_SHADER[] =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float dist = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float width = length(vec2(dFdx(dist), dFdy(dist)));\n"
+    "    float alpha = smoothstep(-width, width, dist);\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * alpha) * colDiffuse;\n"
+    "}\n";
+
+static Font sdf_font = {0};
+static Shader sdf_shader = {0};
+static bool sdf_loaded = false;
+static size_t glyph_bytes = 0; // CPU copy of the glyphs kept by the font
+
+/**
+ * @brief Builds the SDF atlas and shader if the UI font is available
+ *
+ * @details Requires an active window, leaves the default font in use on any failure
+ */
+void load_ui_font(void)
+{
+    int file_size = 0;
+    const unsigned char* packed = find_pak_asset(UI_FONT_PATH, &file_size);
+    if (!packed && !FileExists(UI_FONT_PATH))
+    {
+        TraceLog(LOG_INFO, "No %s, using the default font", UI_FONT_PATH);
+        return;
+    }
+
+    unsigned char* file_data = packed ? NULL : LoadFileData(UI_FONT_PATH, &file_size);
+    if (!packed && file_data == NULL) return;
+
+    sdf_font.baseSize = UI_FONT_BASE_SIZE;
+    sdf_font.glyphCount = 95;
+    sdf_font.glyphs = LoadFontData(packed ? packed : file_data, file_size, UI_FONT_BASE_SIZE, NULL, 0, FONT_SDF);
+    UnloadFileData(file_data);
+
+    if (sdf_font.glyphs == NULL)
+    {
+        TraceLog(LOG_WARNING, "Failed to rasterise %s, using the default font", UI_FONT_PATH);
+        sdf_font = (Font){0};
+        return;
+    }
+
+    const Image atlas = GenImageFontAtlas(sdf_font.glyphs, &sdf_font.recs, sdf_font.glyphCount, UI_FONT_BASE_SIZE,
+                                          0, 1);
+    sdf_font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    if (sdf_font.texture.id != 0) track_alloc(MEM_UI, MEM_GPU, texture_bytes(sdf_font.texture));
+
+    glyph_bytes = (size_t)sdf_font.glyphCount * (sizeof(GlyphInfo) + sizeof(Rectangle));
+    for (int i = 0; i < sdf_font.glyphCount; i++)
+    {
+        const Image* image = &sdf_font.glyphs[i].image;
+        glyph_bytes += (size_t)GetPixelDataSize(image->width, image->height, image->format);
+    }
+    track_alloc(MEM_UI, MEM_HEAP, glyph_bytes);
+    SetTextureFilter(sdf_font.texture, TEXTURE_FILTER_BILINEAR);
+
+    sdf_shader = LoadShaderFromMemory(NULL, SDF_FRAGMENT_SHADER);
+
+    // A failed shader compile falls back to the default shader id
+    if (sdf_font.texture.id == 0 || sdf_shader.id == rlGetShaderIdDefault())
+    {
+        TraceLog(LOG_WARNING, "SDF font setup failed, using the default font");
+        unload_ui_font();
+        return;
+    }
+
+    sdf_loaded = true;
+}
+
+/**
+ * @brief Releases the SDF atlas and shader
+ */
+void unload_ui_font(void)
+{
+    if (sdf_font.texture.id != 0 || sdf_font.glyphs != NULL)
+    {
+        if (sdf_font.texture.id != 0) track_free(MEM_UI, MEM_GPU, texture_bytes(sdf_font.texture));
+        track_free(MEM_UI, MEM_HEAP, glyph_bytes);
+        glyph_bytes = 0;
+        UnloadFont(sdf_font);
+    }
+    if (sdf_shader.id != 0 && sdf_shader.id != rlGetShaderIdDefault())
+    {
+        UnloadShader(sdf_shader);
+    }
+    sdf_font = (Font){0};
+    sdf_shader = (Shader){0};
+    sdf_loaded = false;
+}
+
+/**
+ * @brief Checks if text is drawn from the SDF atlas
+ */
+bool ui_font_is_sdf(void)
+{
+    return sdf_loaded;
+}
+
+/**
+ * @brief Measures text as draw_ui_text() will draw it
+ *
+ * @param text Text to measure
+ * @param font_size Font size in pixels
+ * @return Width of the text in pixels
+ */
+int measure_ui_text(const char* text, const int font_size)
+{
+    if (!sdf_loaded) return MeasureText(text, font_size);
+
+    return (int)MeasureTextEx(sdf_font, text, (float)font_size, (float)font_size / 10.0f).x;
+}
+
+/**
+ * @brief Draws UI text, through the SDF atlas when it is loaded
+ *
+ * @param text Text to draw
+ * @param x X position of the top left corner
+ * @param y Y position of the top left corner
+ * @param font_size Font size in pixels
+ * @param color Text color
+ */
+void draw_ui_text(const char* text, const int x, const int y, const int font_size, const Color color)
+{
+    if (!sdf_loaded)
+    {
+        DrawText(text, x, y, font_size, color);
+        return;
+    }
+
+    BeginShaderMode(sdf_shader);
+    DrawTextEx(sdf_font, text, (Vector2){(float)x, (float)y}, (float)font_size, (float)font_size / 10.0f, color);
+    EndShaderMode();
+}
+
+/**
+ * @brief Draws an X symbol as two thick lines centered in a cell
+ *
+ * @param cell Bounds of the symbol
+ * @param color Symbol color
+ */
+void draw_x_symbol(const Rectangle cell, const Color color)
+{
+    const float thickness = cell.width * 0.12f;
+
+    DrawLineEx((Vector2){cell.x, cell.y}, (Vector2){cell.x + cell.width, cell.y + cell.height}, thickness, color);
+    DrawLineEx((Vector2){cell.x + cell.width, cell.y}, (Vector2){cell.x, cell.y + cell.height}, thickness, color);
+}
+
+/**
+ * @brief Draws an O symbol as a ring centered in a cell
+ *
+ * @param cell Bounds of the symbol
+ * @param color Symbol color
+ */
+void draw_o_symbol(const Rectangle cell, const Color color)
+{
+    const Vector2 center = {cell.x + cell.width / 2, cell.y + cell.height / 2};
+    const float outer_radius = cell.width / 2;
+    const float thickness = cell.width * 0.12f;
+
+    DrawRing(center, outer_radius - thickness, outer_radius, 0.0f, 360.0f, 48, color);
+}
@@ -0,0 +1,223 @@
+/**
+ * @file ui_tree.c
+ * @brief Retained button widgets with a uniform grid hit-test index
+ *
+ * Every screen's buttons are widgets that own their rectangle and tessellated geometry.
+ * Both, and the hit grid, are rebuilt once per layout generation. Hover is resolved only
+ * when the mouse moves, the screen changes or the layout changes, and any change in
+ * hover marks the tree dirty so the next frame is redrawn.
+ */
+#include <ui_tree.h>
+#include <utils.h>
+
+typedef struct {
+    Button* buttons;
+    size_t count;
+    int per_row;
+} ButtonGroup;
+
+static const ButtonGroup SCREEN_BUTTONS[UI_SCREEN_COUNT] = {
+    [UI_SCREEN_MAIN_MENU] = {MAIN_MENU_BUTTONS, sizeof(MAIN_MENU_BUTTONS) / sizeof(Button), 2},
+    [UI_SCREEN_GAME_MODE] = {GAME_MODE_BUTTONS, sizeof(GAME_MODE_BUTTONS) / sizeof(Button), 1},
+    [UI_SCREEN_EXIT] = {EXIT_CONFIRMATION_BUTTONS, sizeof(EXIT_CONFIRMATION_BUTTONS) / sizeof(Button), 1},
+    [UI_SCREEN_INSTRUCTIONS] = {INSTRUCTIONS_BUTTONS, sizeof(INSTRUCTIONS_BUTTONS) / sizeof(Button), 1},
+    [UI_SCREEN_GAME_OVER] = {GAME_OVER_BUTTONS, sizeof(GAME_OVER_BUTTONS) / sizeof(Button), 1},
+    [UI_SCREEN_IN_GAME] = {IN_GAME_BUTTONS, sizeof(IN_GAME_BUTTONS) / sizeof(Button), 1},
+};
+
+static UiTree ui_tree = {.hover_screen = UI_SCREEN_COUNT};
+
+/**
+ * @brief Returns the hit grid cell containing a coordinate, clamped to the grid
+ */
+static int grid_cell(const float value, const float cell_size, const int cell_count)
+{
+    const int cell = (int)(value / cell_size);
+    return cell < 0 ? 0 : cell >= cell_count ? cell_count - 1 : cell;
+}
+
+/**
+ * @brief Lays out the widgets of one screen and rebuilds its hit grid
+ *
+ * @param screen Pointer to the screen
+ * @param group Buttons shown on the screen
+ */
+static void layout_screen(UiScreen* screen, const ButtonGroup* group)
+{
+    const int screen_width = GetScreenWidth();
+    const int screen_height = GetScreenHeight();
+
+    screen->node_count = group->count < MAX_BUTTON_GROUP_SIZE ? (int)group->count : MAX_BUTTON_GROUP_SIZE;
+    screen->per_row = group->per_row;
+    screen->hovered = -1;
+    screen->cell_width = (float)screen_width / HIT_GRID_COLS;
+    screen->cell_height = (float)screen_height / HIT_GRID_ROWS;
+
+    for (int row = 0; row < HIT_GRID_ROWS; row++)
+    {
+        for (int col = 0; col < HIT_GRID_COLS; col++)
+        {
+            screen->cell_counts[row][col] = 0;
+        }
+    }
+
+    for (int i = 0; i < screen->node_count; i++)
+    {
+        UiNode* node = &screen->nodes[i];
+        node->button = &group->buttons[i];
+        node->bounds = calculate_button_rectangle(node->button->width, node->button->padding, node->button->height,
+                                                  node->button->first_render_offset, i, group->per_row,
+                                                  screen_height, screen_width);
+        tessellate_button(&node->geometry, node->bounds, node->button->rounded);
+
+        node->button->rect = &node->bounds;
+        node->button->geometry = &node->geometry;
+        node->button->hovered = false;
+
+        // Register the widget in every cell it overlaps
+        const int first_col = grid_cell(node->bounds.x, screen->cell_width, HIT_GRID_COLS);
+        const int last_col = grid_cell(node->bounds.x + node->bounds.width, screen->cell_width, HIT_GRID_COLS);
+        const int first_row = grid_cell(node->bounds.y, screen->cell_height, HIT_GRID_ROWS);
+        const int last_row = grid_cell(node->bounds.y + node->bounds.height, screen->cell_height, HIT_GRID_ROWS);
+
+        for (int row = first_row; row <= last_row; row++)
+        {
+            for (int col = first_col; col <= last_col; col++)
+            {
+                screen->cells[row][col][screen->cell_counts[row][col]++] = (uint8_t)i;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Lays out every screen's widgets for a new layout generation
+ *
+ * @param generation Layout generation being built
+ */
+void layout_ui_tree(const uint32_t generation)
+{
+    for (int i = 0; i < UI_SCREEN_COUNT; i++)
+    {
+        layout_screen(&ui_tree.screens[i], &SCREEN_BUTTONS[i]);
+    }
+    ui_tree.layout_generation = generation;
+    ui_tree.dirty = true;
+}
+
+/**
+ * @brief Maps a game state to the screen whose buttons it shows
+ *
+ * @param state Current game state
+ * @return Screen id, UI_SCREEN_COUNT if the state has no buttons
+ */
+UiScreenId ui_screen_for_state(const GameState state)
+{
+    switch (state)
+    {
+    case GAME_STATE_MENU:
+        return UI_SCREEN_MAIN_MENU;
+    case MENU_DIFF_CHOICE:
+        return UI_SCREEN_GAME_MODE;
+    case GAME_STATE_EXIT:
+        return UI_SCREEN_EXIT;
+    case MENU_INSTRUCTIONS:
+        return UI_SCREEN_INSTRUCTIONS;
+    case GAME_STATE_P1_WIN:
+    case GAME_STATE_P2_WIN:
+    case GAME_STATE_DRAW:
+        return UI_SCREEN_GAME_OVER;
+    case GAME_STATE_PLAYING:
+        return UI_SCREEN_IN_GAME;
+    default:
+        return UI_SCREEN_COUNT;
+    }
+}
+
+/**
+ * @brief Finds the widget of a screen under a point
+ *
+ * @param screen Screen to search
+ * @param point Point in window coordinates
+ * @return Index of the node, -1 if there is none
+ */
+static int find_node(const UiScreen* screen, const Vector2 point)
+{
+    if (point.x < 0 || point.y < 0 || screen->cell_width <= 0 || screen->cell_height <= 0) return -1;
+
+    const int col = (int)(point.x / screen->cell_width);
+    const int row = (int)(point.y / screen->cell_height);
+    if (col >= HIT_GRID_COLS || row >= HIT_GRID_ROWS) return -1;
+
+    for (int i = 0; i < screen->cell_counts[row][col]; i++)
+    {
+        const int index = screen->cells[row][col][i];
+        if (CheckCollisionPointRec(point, screen->nodes[index].bounds)) return index;
+    }
+    return -1;
+}
+
+/**
+ * @brief Resolves which button of a screen is hovered
+ *
+ * @param screen Screen currently shown
+ * @param mouse_pos Current mouse position
+ * @return true if the hovered button changed
+ *
+ * @details Does nothing unless the mouse moved, the screen changed or the layout changed
+ */
+bool update_ui_hover(const UiScreenId screen, const Vector2 mouse_pos)
+{
+    if (screen >= UI_SCREEN_COUNT) return false;
+
+    if (screen == ui_tree.hover_screen && ui_tree.hover_generation == ui_tree.layout_generation &&
+        mouse_pos.x == ui_tree.hover_mouse.x && mouse_pos.y == ui_tree.hover_mouse.y)
+    {
+        return false;
+    }
+    ui_tree.hover_screen = screen;
+    ui_tree.hover_mouse = mouse_pos;
+    ui_tree.hover_generation = ui_tree.layout_generation;
+
+    UiScreen* ui_screen = &ui_tree.screens[screen];
+    const int hovered = find_node(ui_screen, mouse_pos);
+    if (hovered == ui_screen->hovered) return false;
+
+    if (ui_screen->hovered >= 0) ui_screen->nodes[ui_screen->hovered].button->hovered = false;
+    if (hovered >= 0) ui_screen->nodes[hovered].button->hovered = true;
+    ui_screen->hovered = hovered;
+    ui_tree.dirty = true;
+    return true;
+}
+
+/**
+ * @brief Finds the button of a screen under a point
+ *
+ * @param screen Screen currently shown
+ * @param point Point in window coordinates, e.g. a click
+ * @return Pointer to the button, NULL if there is none
+ */
+Button* ui_hit_test(const UiScreenId screen, const Vector2 point)
+{
+    if (screen >= UI_SCREEN_COUNT) return NULL;
+
+    UiScreen* ui_screen = &ui_tree.screens[screen];
+    const int index = find_node(ui_screen, point);
+    return index >= 0 ? ui_screen->nodes[index].button : NULL;
+}
+
+/**
+ * @brief Checks if anything visible in the UI tree changed since the last drawn frame
+ */
+bool ui_tree_dirty(void)
+{
+    return ui_tree.dirty;
+}
+
+/**
+ * @brief Marks the UI tree as drawn
+ */
+void clear_ui_tree_dirty(void)
+{
+    ui_tree.dirty = false;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file update.c
+ * @brief Update phase of the main loop
+ *
+ * Input is handled once per loop iteration, timers, transitions and AI completion
+ * advance in fixed SIM_TICK_SECONDS steps. Nothing here draws, so the render phase
+ * can be skipped or throttled without changing game timing.
+ */
+#include <update.h>
+#include <ai_worker.h>
+#include <computer.h>
+#include <handlers.h>
+#include <render.h>
+#include <resource_manager.h>
+
+/**
+ * @brief Starts a simulation clock at the current time
+ *
+ * @param clock Pointer to the SimClock
+ */
+void init_sim_clock(SimClock* clock)
+{
+    clock->last_time = GetTime();
+    clock->accumulator = 0.0;
+}
+
+/**
+ * @brief Handles keyboard and mouse input for the current state
+ *
+ * @param resources Game asset resources
+ * @param context Current game context
+ */
+void process_input(const GameResources* resources, GameContext* context)
+{
+    // F3 toggles search statistics collection, overlay and log line
+    if (IsKeyPressed(KEY_F3)) context->search_stats_enabled = !context->search_stats_enabled;
+    // F4 toggles the memory overlay
+    if (IsKeyPressed(KEY_F4)) context->memory_stats_enabled = !context->memory_stats_enabled;
+
+    // Click handling, hover is only resolved again when the mouse moved
+    const Vector2 mouse_pos = GetMousePosition();
+    update_ui_hover(ui_screen_for_state(context->state), mouse_pos);
+    if (WindowShouldClose()) context->exit_flag = true;
+
+    if (!IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) return;
+
+    switch (context->state)
+    {
+    case GAME_STATE_MENU:
+        handle_menu_click(mouse_pos, resources, context);
+        break;
+    case GAME_STATE_PLAYING:
+        if (context->start_screen_shown)
+        {
+            handle_game_click(mouse_pos, resources, context);
+        }
+        break;
+    case GAME_STATE_P1_WIN:
+    case GAME_STATE_P2_WIN:
+    case GAME_STATE_DRAW:
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_GAME_OVER);
+        break;
+    case GAME_STATE_EXIT:
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_EXIT);
+        break;
+    case MENU_DIFF_CHOICE:
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_GAME_MODE);
+        break;
+    case MENU_INSTRUCTIONS:
+        handle_clicks(mouse_pos, resources, context, UI_SCREEN_INSTRUCTIONS);
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Advances transitions and applies finished AI moves by one fixed step
+ *
+ * @param resources Game asset resources
+ * @param context Current game context
+ * @param dt Length of the step in seconds
+ */
+void simulate_tick(const GameResources* resources, GameContext* context, const double dt)
+{
+    switch (context->state)
+    {
+    case GAME_STATE_PLAYING:
+        if (context->start_screen_shown) break;
+
+        // "Who starts" message, the first move is made once it is gone
+        if (!context->transition.active)
+        {
+            context->transition.active = true;
+            context->transition.elapsed = 0.0;
+        }
+        context->transition.elapsed += dt;
+
+        if (context->transition.elapsed >= TRANSITION_SECONDS)
+        {
+            context->transition.active = false;
+            context->start_screen_shown = true;
+            if (current_player == get_computer_player(context) && context->computer_enabled)
+            {
+                ai_worker_submit(context->ai_worker, context);
+            }
+            else
+            {
+                ai_worker_ponder(context->ai_worker, context);
+            }
+        }
+        break;
+    case GAME_STATE_P1_WIN:
+    case GAME_STATE_P2_WIN:
+    case GAME_STATE_DRAW:
+        // The game over popup appears once the final board has been shown for a while
+        if (!context->transition.active)
+        {
+            context->transition.active = true;
+            context->transition.elapsed = 0.0;
+        }
+        else if (context->transition.elapsed < TRANSITION_SECONDS)
+        {
+            context->transition.elapsed += dt;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Apply the computer's move once the background search finishes
+    EvalResult ai_result;
+    if (ai_worker_poll(context->ai_worker, &ai_result, &context->last_search_stats))
+    {
+        if (context->search_stats_enabled)
+        {
+            char stats_line[256];
+            format_search_stats(&context->last_search_stats, stats_line, sizeof(stats_line));
+            TraceLog(LOG_INFO, "Search (%s): move %d %s", get_game_mode_name(&context->selected_game_mode),
+                     ai_result.move, stats_line);
+        }
+        handle_computer_move(resources, context, ai_result);
+
+        // Search the computer's answers while the human thinks about their move
+        if (context->state == GAME_STATE_PLAYING)
+        {
+            ai_worker_ponder(context->ai_worker, context);
+        }
+    }
+}
+
+/**
+ * @brief Runs the update phase for the time passed since the last call
+ *
+ * @param clock Pointer to the SimClock
+ * @param resources Game asset resources
+ * @param context Current game context
+ * @return Number of fixed steps simulated
+ *
+ * @details Steps that cannot be caught up within MAX_SIM_TICKS_PER_UPDATE are dropped,
+ * e.g. after the window was dragged, rather than fast-forwarding the game
+ */
+int update_game(SimClock* clock, const GameResources* resources, GameContext* context)
+{
+    const double now = GetTime();
+    clock->accumulator += now - clock->last_time;
+    clock->last_time = now;
+
+    process_input(resources, context);
+
+    // Load what the new state or mode needs before a tick can use it
+    set_resource_scope(context->state, context->selected_game_mode);
+
+    int ticks = 0;
+    while (clock->accumulator >= SIM_TICK_SECONDS && ticks < MAX_SIM_TICKS_PER_UPDATE)
+    {
+        simulate_tick(resources, context, SIM_TICK_SECONDS);
+        clock->accumulator -= SIM_TICK_SECONDS;
+        ticks++;
+    }
+
+    if (ticks == MAX_SIM_TICKS_PER_UPDATE)
+    {
+        clock->accumulator = 0.0;
+    }
+    return ticks;
+}
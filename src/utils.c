@@ -1,7 +1,55 @@
 #include "utils.h"
 
 #include <common.h>
+#include <memo.h>
 #include <raylib.h>
+#include <string.h>
+#include <ui_text.h>
+
+typedef struct {
+    float btn_width;
+    float btn_height;
+    float padding[4]; // left, right, up, down
+    float first_button_offset;
+    int index;
+    int buttons_per_row;
+    int screen_height;
+    int screen_width;
+} ButtonRectKey;
+
+typedef struct {
+    TextKey text;
+    float ref[4];     // x, y, width, height
+    float offset[2];  // vertical, horizontal share of the reference rectangle
+} TextPlacementKey;
+
+DEFINE_MEMO(button_rect, ButtonRectKey, Rectangle, MEMO_FUNCTION_CAPACITY)
+DEFINE_MEMO(centered_text, TextPlacementKey, Coords, MEMO_FUNCTION_CAPACITY)
+DEFINE_MEMO(offset_text, TextPlacementKey, Coords, MEMO_FUNCTION_CAPACITY)
+
+/**
+ * Fills the memo key of a text placement
+ *
+ * @return false if the message is too long to be memoized
+ */
+static bool make_text_placement_key(TextPlacementKey* key, const char* message, const int font_size,
+                                    const float ref_x, const float ref_y, const float ref_width,
+                                    const float ref_height, const float vertical, const float horizontal)
+{
+    const size_t length = strlen(message);
+    if (length >= TEXT_CACHE_MAX_LEN) return false;
+
+    memset(key, 0, sizeof(TextPlacementKey));
+    key->text.font_size = font_size;
+    memcpy(key->text.text, message, length);
+    key->ref[0] = ref_x;
+    key->ref[1] = ref_y;
+    key->ref[2] = ref_width;
+    key->ref[3] = ref_height;
+    key->offset[0] = vertical;
+    key->offset[1] = horizontal;
+    return true;
+}
 
 /**
  * Calculates centered box dimensions
@@ -21,40 +69,31 @@ BoxDimensions calculate_centered_box_dimensions(const float width_percentage, co
                                                 const int screen_height, const int screen_width, MemoCache
                                                 * cache)
 {
-    // Create key
-    BoxKey key = {
-        .width_percentage = width_percentage,
-        .height_percentage = height_percentage,
-        .screen_height = screen_height,
-        .screen_width = screen_width
-    };
+    // Create key, zeroed so padding never reaches the bytewise hash
+    BoxKey key;
+    memset(&key, 0, sizeof(BoxKey));
+    key.width_percentage = width_percentage;
+    key.height_percentage = height_percentage;
+    key.screen_height = screen_height;
+    key.screen_width = screen_width;
 
-    // Find entry in cache
-    BoxCache* entry = NULL;
-    HASH_FIND(hh, cache->box_cache, &key, sizeof(BoxKey), entry);
-
-    if (entry)
+    // If entry found return it
+    BoxDimensions box;
+    if (memo_table_get(&cache->boxes, &key, &box))
     {
-        // If entry found return it
-        return entry->result;
+        return box;
     }
 
     // Calculate
-    BoxDimensions box = {
+    box = (BoxDimensions){
         .width = (float)screen_width * width_percentage,
         .height = (float)screen_height * height_percentage,
         .x = ((float)screen_width - ((float)screen_width * width_percentage)) / 2,
         .y = ((float)screen_height - ((float)screen_height * height_percentage)) / 2
     };
 
-    // Saves entry after calculating
-    BoxCache* new_entry = malloc(sizeof(BoxCache));
-    if (new_entry) {
-        new_entry->key = key;
-        new_entry->result = box;
-        HASH_ADD(hh, cache->box_cache, key, sizeof(BoxKey), new_entry);
-    }
-
+    // Saves entry after calculating, replaces a cold entry once the table is full
+    memo_table_put(&cache->boxes, &key, &box);
 
     return box;
 }
@@ -79,6 +118,22 @@ Rectangle calculate_button_rectangle(const float btn_width, const ComponentPaddi
 
 )
 {
+    ButtonRectKey key;
+    memset(&key, 0, sizeof(ButtonRectKey));
+    key.btn_width = btn_width;
+    key.btn_height = btn_height;
+    key.padding[0] = btn_padding.left;
+    key.padding[1] = btn_padding.right;
+    key.padding[2] = btn_padding.up;
+    key.padding[3] = btn_padding.down;
+    key.first_button_offset = first_button_offset;
+    key.index = index;
+    key.buttons_per_row = buttons_per_row;
+    key.screen_height = screen_height;
+    key.screen_width = screen_width;
+
+    Rectangle result;
+    if (button_rect_memo_get(&key, &result)) return result;
 
     const float btn_spacing = btn_padding.up + btn_padding.down;
     const float horizontal_spacing = btn_padding.left + btn_padding.right;
@@ -93,13 +148,50 @@ Rectangle calculate_button_rectangle(const float btn_width, const ComponentPaddi
     const int row = index / buttons_per_row;
     const int col = index % buttons_per_row;
 
-    const Rectangle result = {
+    result = (Rectangle){
         base_x + col * (btn_width + horizontal_spacing), start_y + row * (btn_height + btn_spacing),
         btn_width, btn_height
     };
+    button_rect_memo_put(&key, &result);
     return result;
 }
 
+/**
+ * Measures the width of a text string, reusing earlier measurements
+ *
+ * @param message Text string to be measured
+ * @param font_size Size of the font used for rendering
+ * @param cache Memoization cache, may be NULL to measure directly
+ *
+ * @return Width of the text in pixels
+ *
+ * @note Strings longer than TEXT_CACHE_MAX_LEN - 1 characters are always measured directly
+ */
+int measure_text_cached(const char* message, const int font_size, MemoCache* cache)
+{
+    const size_t length = strlen(message);
+    if (!cache || length >= TEXT_CACHE_MAX_LEN)
+    {
+        return measure_ui_text(message, font_size);
+    }
+
+    TextKey key;
+    memset(&key, 0, sizeof(TextKey));
+    key.font_size = font_size;
+    memcpy(key.text, message, length);
+
+    int width;
+    if (memo_table_get(&cache->text_widths, &key, &width))
+    {
+        return width;
+    }
+
+    width = measure_ui_text(message, font_size);
+    memo_table_put(&cache->text_widths, &key, &width);
+
+    return width;
+}
+
 /**
  * Calculates centered text coordinates within a reference rectangle
  *
@@ -109,17 +201,25 @@ Rectangle calculate_button_rectangle(const float btn_width, const ComponentPaddi
  * @param ref_y Y-coordinate of reference rectangle's top-left corner
  * @param ref_width Width of reference rectangle
  * @param ref_height Height of reference rectangle
+ * @param cache Memoization cache for text measurements, may be NULL
  *
  * @return Coords struct with calculated x and y for positioning
  */
 Coords calculate_centered_text_xy(const char* message, const int font_size, const float ref_x, const float ref_y,
-                                  const float ref_width, const float ref_height)
+                                  const float ref_width, const float ref_height, MemoCache* cache)
 {
-    const int text_width = MeasureText(message, font_size);
-    const Coords coords = {
+    TextPlacementKey key;
+    const bool memoized = cache && make_text_placement_key(&key, message, font_size, ref_x, ref_y, ref_width,
+                                                           ref_height, 0.5f, 0.5f);
+    Coords coords;
+    if (memoized && centered_text_memo_get(&key, &coords)) return coords;
+
+    const int text_width = measure_text_cached(message, font_size, cache);
+    coords = (Coords){
         .x = ref_x + (ref_width - (float)text_width) / 2,
         .y = ref_y + (ref_height - (float)font_size) / 2
     };
+    if (memoized) centered_text_memo_put(&key, &coords);
     return coords;
 }
 
@@ -135,7 +235,7 @@ Coords calculate_centered_text_xy(const char* message, const int font_size, cons
  * @param ref_height Height of reference rectangle
  * @param vertical_offset_percent Vertical offset percentage within reference rectangle (0.0 - 1.0)
  * @param horizontal_offset_percent Horizontal offset percentage within reference rectangle (0.0 - 1.0)
- * @param cache Optional memoization cache (unused in this implementation)
+ * @param cache Memoization cache for text measurements, may be NULL
  *
  * @return Coords struct with calculated x and y for positioning
  */
@@ -143,11 +243,19 @@ Coords calculate_text_xy_offset(const char* message, const int font_size, const
                                 const float ref_width, const float ref_height, const float vertical_offset_percent,
                                 const float horizontal_offset_percent, MemoCache* cache)
 {
-    const int text_width = MeasureText(message, font_size);
-    const Coords coords = {
+    TextPlacementKey key;
+    const bool memoized = cache && make_text_placement_key(&key, message, font_size, ref_x, ref_y, ref_width,
+                                                           ref_height, vertical_offset_percent,
+                                                           horizontal_offset_percent);
+    Coords coords;
+    if (memoized && offset_text_memo_get(&key, &coords)) return coords;
+
+    const int text_width = measure_text_cached(message, font_size, cache);
+    coords = (Coords){
         .x = ref_x + ref_width * horizontal_offset_percent - (float)text_width / 2,
         .y = ref_y + ref_height * vertical_offset_percent - (float)font_size / 2
     };
+    if (memoized) offset_text_memo_put(&key, &coords);
     return coords;
 }
 
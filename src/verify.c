@@ -0,0 +1,419 @@
+/**
+ * @file verify.c
+ * @brief Exhaustive differential check of the engine fast paths against reference implementations
+ *
+ * Every reachable position is enumerated and split across threads. Each production
+ * path (check_win, check_draw in C or asm, minimax, nn_move, nb_move and the
+ * instrumented search) is compared with the straightforward reference versions kept
+ * below. Moves must match exactly, scores within VERIFY_SCORE_TOLERANCE.
+ */
+#include <verify.h>
+#include <computer.h>
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <tgmath.h>
+#include <time.h>
+
+#define REACHABLE_POSITIONS 5478
+#define VERIFY_THREADS 8
+#define VERIFY_SCORE_TOLERANCE 1e-9
+#define MAX_REPORTED_FAILURES 20
+
+typedef struct {
+    uint16_t x;
+    uint16_t o;
+} Position;
+
+typedef struct {
+    const AiModels* models;
+    const Position* positions;
+    size_t begin;
+    size_t end;
+    uint64_t checks;
+    uint64_t failures;
+} VerifyShard;
+
+static const uint16_t REF_WIN_LINES[8][3] = {
+    {0, 1, 2}, {3, 4, 5}, {6, 7, 8}, {0, 3, 6}, {1, 4, 7}, {2, 5, 8}, {0, 4, 8}, {2, 4, 6}
+};
+
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+static int reported_failures = 0;
+
+/***************************************************************/
+/*                  Reference implementations                  */
+/***************************************************************/
+
+/**
+ * @brief Reference win check, same pattern order as check_win
+ *
+ * @details Production numbers the patterns as rows, then columns right to left, then diagonals
+ */
+static int ref_check_win(const uint16_t board)
+{
+    static const int PATTERN_ORDER[8] = {0, 1, 2, 5, 4, 3, 6, 7};
+    for (int i = 0; i < 8; i++)
+    {
+        const uint16_t* line = REF_WIN_LINES[PATTERN_ORDER[i]];
+        if (board >> line[0] & 1 && board >> line[1] & 1 && board >> line[2] & 1) return i;
+    }
+    return -1;
+}
+
+static bool ref_check_draw(const uint16_t x, const uint16_t o)
+{
+    for (int cell = 0; cell < 9; cell++)
+    {
+        if (!((x | o) >> cell & 1)) return false;
+    }
+    return true;
+}
+
+static EvalResult ref_minimax(const uint16_t x, const uint16_t o, const player_t player, int alpha, int beta,
+                              const int depth, const player_t human, const player_t computer)
+{
+    const uint16_t human_board = human == PLAYER_X ? x : o;
+    const uint16_t computer_board = computer == PLAYER_X ? x : o;
+    if (ref_check_win(human_board) != -1) return (EvalResult){-1, -1};
+    if (ref_check_win(computer_board) != -1) return (EvalResult){1, -1};
+    if (ref_check_draw(x, o) || depth == 0) return (EvalResult){0, -1};
+
+    double best_score = player == computer ? -2 : 2;
+    int best_move = -1;
+
+    for (int move = 0; move < 9; move++)
+    {
+        if ((x | o) >> move & 1) continue;
+
+        const uint16_t next_x = player == PLAYER_X ? x | 1 << move : x;
+        const uint16_t next_o = player == PLAYER_O ? o | 1 << move : o;
+        const EvalResult result = ref_minimax(next_x, next_o, player == human ? computer : human, alpha, beta,
+                                              depth - 1, human, computer);
+
+        if (player == computer)
+        {
+            if (result.score > best_score)
+            {
+                best_score = result.score;
+                best_move = move;
+            }
+            alpha = alpha > best_score ? alpha : best_score;
+        }
+        else
+        {
+            if (result.score < best_score)
+            {
+                best_score = result.score;
+                best_move = move;
+            }
+            beta = beta < best_score ? beta : best_score;
+        }
+        if (alpha >= beta) break;
+    }
+    return (EvalResult){best_score, best_move};
+}
+
+static EvalResult ref_nn_move(const NeuralNetwork* nn, const uint16_t x, const uint16_t o, const player_t computer)
+{
+    double best_score = -INFINITY;
+    int best_move = -1;
+
+    for (int move = 0; move < 9; move++)
+    {
+        if ((x | o) >> move & 1) continue;
+
+        const uint16_t own = (computer == PLAYER_X ? x : o) | 1 << move;
+        const uint16_t other = computer == PLAYER_X ? o : x;
+
+        double hidden[HIDDEN_NODES];
+        for (int i = 0; i < HIDDEN_NODES; i++)
+        {
+            hidden[i] = nn->bias_hidden[i];
+            for (int j = 0; j < INPUT_NODES; j++)
+            {
+                const double input = own >> j & 1 ? 1.0 : other >> j & 1 ? -1.0 : 0.0;
+                hidden[i] += nn->hidden_weights[i][j] * input;
+            }
+            hidden[i] = hidden[i] > 0 ? hidden[i] : 0.0;
+        }
+        double output = nn->bias_output[0];
+        for (int j = 0; j < HIDDEN_NODES; j++)
+        {
+            output += nn->output_weights[0][j] * hidden[j];
+        }
+        output = 1.0 / (1.0 + exp(-output));
+
+        if (output > best_score)
+        {
+            best_score = output;
+            best_move = move;
+        }
+    }
+    return (EvalResult){(int)best_score, best_move};
+}
+
+static EvalResult ref_nb_move(const BayesModel* model, const uint16_t x, const uint16_t o, const player_t computer)
+{
+    double best_score = -1;
+    int best_move = -1;
+
+    for (int move = 0; move < 9; move++)
+    {
+        if ((x | o) >> move & 1) continue;
+
+        // The model sees the computer as X
+        const uint16_t own = (computer == PLAYER_X ? x : o) | 1 << move;
+        const uint16_t other = computer == PLAYER_X ? o : x;
+        double win = model->prob_win;
+        double lose = model->prob_lose;
+        for (int pos = 0; pos < 9; pos++)
+        {
+            const double p = own >> pos & 1 ? model->prob_x[pos]
+                           : other >> pos & 1 ? model->prob_o[pos]
+                           : model->prob_b[pos];
+            win *= p;
+            lose *= p;
+        }
+        const double score = win / (win + lose);
+
+        if (score > best_score)
+        {
+            best_score = score;
+            best_move = move;
+        }
+    }
+    return (EvalResult){best_score, best_move};
+}
+
+/***************************************************************/
+/*                         Harness                             */
+/***************************************************************/
+
+static void report_failure(VerifyShard* shard, const Position* position, const char* what, const double expected,
+                           const double actual)
+{
+    shard->failures++;
+    pthread_mutex_lock(&report_lock);
+    if (reported_failures++ < MAX_REPORTED_FAILURES)
+    {
+        TraceLog(LOG_ERROR, "Verify: %s mismatch at x=0x%03x o=0x%03x, expected %g got %g", what, position->x,
+                 position->o, expected, actual);
+    }
+    pthread_mutex_unlock(&report_lock);
+}
+
+static void expect_equal_result(VerifyShard* shard, const Position* position, const char* what,
+                                const EvalResult expected, const EvalResult actual)
+{
+    shard->checks++;
+    if (expected.move != actual.move)
+    {
+        report_failure(shard, position, what, expected.move, actual.move);
+    }
+    else if (fabs(expected.score - actual.score) > VERIFY_SCORE_TOLERANCE)
+    {
+        report_failure(shard, position, what, expected.score, actual.score);
+    }
+}
+
+static void verify_position(VerifyShard* shard, const Position* position)
+{
+    x_board = position->x;
+    o_board = position->o;
+
+    for (player_t player = PLAYER_X; player <= PLAYER_O; player++)
+    {
+        const int expected_win = ref_check_win(player == PLAYER_X ? position->x : position->o);
+        const int win = check_win(player);
+        shard->checks++;
+        if (win != expected_win) report_failure(shard, position, "check_win", expected_win, win);
+    }
+
+    const bool expected_draw = ref_check_draw(position->x, position->o);
+    const bool draw = check_draw();
+    shard->checks++;
+    if (draw != expected_draw) report_failure(shard, position, "check_draw", expected_draw, draw);
+
+    // Engines are only asked to move in unfinished positions
+    if (ref_check_win(position->x) != -1 || ref_check_win(position->o) != -1 || expected_draw) return;
+
+    int x_count = 0;
+    int o_count = 0;
+    for (int cell = 0; cell < 9; cell++)
+    {
+        x_count += position->x >> cell & 1;
+        o_count += position->o >> cell & 1;
+    }
+    const player_t computer = x_count == o_count ? PLAYER_X : PLAYER_O;
+    const player_t human = computer == PLAYER_X ? PLAYER_O : PLAYER_X;
+
+    GameContext context = {
+        .computer_enabled = true,
+        .player_1 = human,
+    };
+
+    static const struct {
+        GameMode mode;
+        const char* name;
+    } ENGINES[] = {
+        {ONE_PLAYER_EASY_NAIVE, "nb_move"},
+        {ONE_PLAYER_EASY_NN, "nn_move"},
+        {ONE_PLAYER_MEDIUM, "minimax depth 3"},
+        {ONE_PLAYER_HARD, "minimax depth 9"},
+    };
+
+    for (size_t i = 0; i < sizeof(ENGINES) / sizeof(ENGINES[0]); i++)
+    {
+        EvalResult expected;
+        switch (ENGINES[i].mode)
+        {
+        case ONE_PLAYER_EASY_NAIVE:
+            if (!shard->models->bayes_model) continue;
+            expected = ref_nb_move(shard->models->bayes_model, position->x, position->o, computer);
+            break;
+        case ONE_PLAYER_EASY_NN:
+            if (!shard->models->neural_network) continue;
+            expected = ref_nn_move(shard->models->neural_network, position->x, position->o, computer);
+            break;
+        case ONE_PLAYER_MEDIUM:
+            expected = ref_minimax(position->x, position->o, computer, -2, 2, 3, human, computer);
+            break;
+        default:
+            expected = ref_minimax(position->x, position->o, computer, -2, 2, 9, human, computer);
+            break;
+        }
+
+        context.selected_game_mode = ENGINES[i].mode;
+        SearchStats stats;
+        const EvalResult plain = choose_computer_move(&context, shard->models, NULL);
+        const EvalResult instrumented = choose_computer_move(&context, shard->models, &stats);
+        expect_equal_result(shard, position, ENGINES[i].name, expected, plain);
+        expect_equal_result(shard, position, "instrumented search", plain, instrumented);
+
+        // Engines must leave the board as they found it
+        shard->checks++;
+        if (x_board != position->x || o_board != position->o)
+        {
+            report_failure(shard, position, "board restore", position->x | position->o << 9, x_board | o_board << 9);
+            x_board = position->x;
+            o_board = position->o;
+        }
+    }
+}
+
+static void* verify_shard(void* arg)
+{
+    VerifyShard* shard = arg;
+    for (size_t i = shard->begin; i < shard->end; i++)
+    {
+        verify_position(shard, &shard->positions[i]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Collects every position reachable from the empty board, X moving first
+ */
+static void enumerate_positions(const uint16_t x, const uint16_t o, const player_t player, uint8_t* seen,
+                                Position* positions, size_t* count)
+{
+    const uint32_t key = (uint32_t)x | (uint32_t)o << 9;
+    if (seen[key >> 3] & 1 << (key & 7)) return;
+    seen[key >> 3] |= 1 << (key & 7);
+    positions[(*count)++] = (Position){x, o};
+
+    if (ref_check_win(x) != -1 || ref_check_win(o) != -1 || ref_check_draw(x, o)) return;
+
+    for (int move = 0; move < 9; move++)
+    {
+        if ((x | o) >> move & 1) continue;
+        if (player == PLAYER_X)
+        {
+            enumerate_positions(x | 1 << move, o, PLAYER_O, seen, positions, count);
+        }
+        else
+        {
+            enumerate_positions(x, o | 1 << move, PLAYER_X, seen, positions, count);
+        }
+    }
+}
+
+/**
+ * @brief Verifies every engine fast path on all reachable positions
+ *
+ * @return EXIT_SUCCESS when every check matches the reference, EXIT_FAILURE otherwise
+ */
+int run_engine_verification(void)
+{
+    struct timespec start, end;
+    timespec_get(&start, TIME_UTC);
+
+    uint8_t* seen = calloc(1 << 15, 1);
+    Position* positions = malloc(sizeof(Position) * REACHABLE_POSITIONS);
+    AiModels* models = load_ai_models();
+    if (!seen || !positions || !models)
+    {
+        TraceLog(LOG_ERROR, "Verify: out of memory");
+        free(seen);
+        free(positions);
+        unload_ai_models(models);
+        return EXIT_FAILURE;
+    }
+
+    size_t count = 0;
+    enumerate_positions(0, 0, PLAYER_X, seen, positions, &count);
+    free(seen);
+
+    uint64_t checks = 0;
+    uint64_t failures = 0;
+
+    // The model engines are skipped without their model, which must not pass as verified
+    if (!models->bayes_model)
+    {
+        TraceLog(LOG_ERROR, "Verify: naive Bayes model failed to load, nb_move not verified");
+        failures++;
+    }
+    if (!models->neural_network)
+    {
+        TraceLog(LOG_ERROR, "Verify: neural network failed to load, nn_move not verified");
+        failures++;
+    }
+
+    if (count != REACHABLE_POSITIONS)
+    {
+        TraceLog(LOG_ERROR, "Verify: enumerated %zu positions, expected %d", count, REACHABLE_POSITIONS);
+        failures++;
+    }
+
+    VerifyShard shards[VERIFY_THREADS];
+    pthread_t threads[VERIFY_THREADS];
+    bool started[VERIFY_THREADS];
+    for (int i = 0; i < VERIFY_THREADS; i++)
+    {
+        shards[i] = (VerifyShard){
+            .models = models,
+            .positions = positions,
+            .begin = count * i / VERIFY_THREADS,
+            .end = count * (i + 1) / VERIFY_THREADS,
+        };
+        started[i] = pthread_create(&threads[i], NULL, verify_shard, &shards[i]) == 0;
+        if (!started[i]) verify_shard(&shards[i]); // Fall back to this thread
+    }
+    for (int i = 0; i < VERIFY_THREADS; i++)
+    {
+        if (started[i]) pthread_join(threads[i], NULL);
+        checks += shards[i].checks;
+        failures += shards[i].failures;
+    }
+
+    timespec_get(&end, TIME_UTC);
+    const double elapsed = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    TraceLog(failures ? LOG_ERROR : LOG_INFO, "Verify: %zu positions, %llu checks, %llu failures in %.2fs", count,
+             (unsigned long long)checks, (unsigned long long)failures, elapsed);
+
+    free(positions);
+    unload_ai_models(models);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file asset_packer.c
+ * @brief Build tool writing the asset pak read by asset_pak.c
+ *
+ * Usage: asset_packer <output.pak> <file>...
+ *
+ * Each file is stored under the path it was given, so run it from the source root
+ * with paths like assets/main1.png. Entries are sorted by name for binary search and
+ * aligned to ASSET_PAK_ALIGNMENT. The files are stored as they are: images and audio
+ * are already compressed and are decoded straight from the pak at runtime.
+ */
+#include <asset_pak.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    AssetPakEntry entry;
+    unsigned char* data;
+} PackedFile;
+
+static int compare_packed_name(const void* a, const void* b)
+{
+    return strcmp(((const PackedFile*)a)->entry.name, ((const PackedFile*)b)->entry.name);
+}
+
+/**
+ * @brief Reads a whole file into memory
+ *
+ * @return true on success
+ */
+static bool read_file(const char* path, PackedFile* packed)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    bool ok = fseek(file, 0, SEEK_END) == 0;
+    const long size = ok ? ftell(file) : -1;
+    ok = size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if (ok)
+    {
+        packed->entry.size = (uint64_t)size;
+        packed->data = malloc(size > 0 ? (size_t)size : 1);
+        ok = packed->data && fread(packed->data, 1, (size_t)size, file) == (size_t)size;
+    }
+    fclose(file);
+    return ok;
+}
+
+static bool write_padding(FILE* out, uint64_t* position)
+{
+    static const unsigned char zeros[ASSET_PAK_ALIGNMENT] = {0};
+    const uint64_t padding = (ASSET_PAK_ALIGNMENT - *position % ASSET_PAK_ALIGNMENT) % ASSET_PAK_ALIGNMENT;
+    *position += padding;
+    return fwrite(zeros, 1, (size_t)padding, out) == padding;
+}
+
+int main(const int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "Usage: %s <output.pak> <file>...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const int count = argc - 2;
+    PackedFile* files = calloc((size_t)count, sizeof(PackedFile));
+    if (!files)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const char* path = argv[i + 2];
+        if (strlen(path) >= ASSET_PAK_NAME_LEN)
+        {
+            fprintf(stderr, "Path too long for the pak index: %s\n", path);
+            return EXIT_FAILURE;
+        }
+        strcpy(files[i].entry.name, path);
+        if (!read_file(path, &files[i]))
+        {
+            fprintf(stderr, "Failed to read %s\n", path);
+            return EXIT_FAILURE;
+        }
+    }
+
+    qsort(files, (size_t)count, sizeof(PackedFile), compare_packed_name);
+    for (int i = 1; i < count; i++)
+    {
+        if (strcmp(files[i - 1].entry.name, files[i].entry.name) == 0)
+        {
+            fprintf(stderr, "Duplicate entry %s\n", files[i].entry.name);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Lay out the data after the index
+    uint64_t position = sizeof(AssetPakHeader) + (uint64_t)count * sizeof(AssetPakEntry);
+    for (int i = 0; i < count; i++)
+    {
+        position += (ASSET_PAK_ALIGNMENT - position % ASSET_PAK_ALIGNMENT) % ASSET_PAK_ALIGNMENT;
+        files[i].entry.offset = position;
+        position += files[i].entry.size;
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (!out)
+    {
+        fprintf(stderr, "Failed to create %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const AssetPakHeader header = {ASSET_PAK_MAGIC, ASSET_PAK_VERSION, (uint32_t)count, 0};
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1;
+    for (int i = 0; ok && i < count; i++)
+    {
+        ok = fwrite(&files[i].entry, sizeof(AssetPakEntry), 1, out) == 1;
+    }
+
+    position = sizeof(AssetPakHeader) + (uint64_t)count * sizeof(AssetPakEntry);
+    for (int i = 0; ok && i < count; i++)
+    {
+        ok = write_padding(out, &position) &&
+            fwrite(files[i].data, 1, (size_t)files[i].entry.size, out) == files[i].entry.size;
+        position += files[i].entry.size;
+        free(files[i].data);
+    }
+
+    if (fclose(out) != 0 || !ok)
+    {
+        fprintf(stderr, "Failed to write %s\n", argv[1]);
+        remove(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    printf("Packed %d assets into %s, %llu bytes\n", count, argv[1], (unsigned long long)position);
+    free(files);
+    return EXIT_SUCCESS;
+}